@@ -43,7 +43,7 @@ namespace pul
 
 	/// CHRONO: Cast
 	template<typename _To, typename _From>
-	pf_decl_inline pf_decl_constexpr
+	pf_decl_inline pf_decl_constexpr _To
 	duration_cast(
 	 _From const &__from)
 	{
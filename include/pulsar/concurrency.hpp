@@ -27,9 +27,17 @@
 // Pulsar
 namespace pul
 {
+	/// CONCURRENCY: Hardware Concurrency
+	/*! @brief Number of logical CPUs this process may actually use: the affinity mask intersected
+	 *				 with the cgroup CPU quota. Never less than 2, the pool keeps at least one worker.
+	 */
+	pf_hint_nodiscard pulsar_api uint32_t
+	__ccy_hardware_concurrency() pf_attr_noexcept;
+
 	/// CONCURRENCY: Constants
-	pf_decl_inline uint32_t CCY_NUM_THREADS								 = std::thread::hardware_concurrency();
+	pf_decl_inline uint32_t CCY_NUM_THREADS								 = __ccy_hardware_concurrency();
 	pf_decl_inline uint32_t CCY_NUM_WORKERS								 = CCY_NUM_THREADS - 1;
+	pf_decl_inline uint32_t CCY_MAX_THREADS								 = 2 * CCY_NUM_THREADS + 64;	// NOTE: Live threads this_thread::get_idx() tells apart, pools and user threads alike
 	pf_decl_inline pf_decl_constexpr align_val_t CCY_ALIGN = align_val_t(64);
 
 	/// CONCURRENCY: Atomic
@@ -70,8 +78,33 @@ namespace pul
 			std::this_thread::yield();
 		}
 
-		// Local counter
-		pf_decl_static pf_decl_inline atomic<thread_id_t> __idx_counter = 0;
+		// Local index
+		/*! @brief Takes the lowest free index below CCY_MAX_THREADS, aborts once they are all in use.
+		 */
+		pf_hint_nodiscard pulsar_api thread_id_t
+		__idx_acquire() pf_attr_noexcept;
+		pulsar_api void
+		__idx_release(
+		 thread_id_t __idx) pf_attr_noexcept;
+		pf_hint_nodiscard pulsar_api uint32_t
+		__idx_num_live() pf_attr_noexcept;
+
+		struct __idx_local_t
+		{
+			/// Constructors
+			__idx_local_t() pf_attr_noexcept
+				: idx(__idx_acquire())
+			{}
+
+			/// Destructor
+			~__idx_local_t() pf_attr_noexcept
+			{
+				__idx_release(this->idx);
+			}
+
+			/// Store
+			thread_id_t idx;
+		};
 
 		// IDs
 		pf_hint_nodiscard pf_decl_always_inline thread_id_t
@@ -82,10 +115,216 @@ namespace pul
 		pf_hint_nodiscard pf_decl_always_inline thread_id_t
 		get_idx() pf_attr_noexcept
 		{
-			pf_decl_thread_local thread_id_t __idx_local = __idx_counter.fetch_add(1, atomic_order::relaxed);
-			return __idx_local % CCY_NUM_THREADS;
+			pf_decl_thread_local __idx_local_t __idx_local;	 // NOTE: Unique among live threads, recycled when they exit
+			return __idx_local.idx;
 		}
 	}	 // namespace this_thread
+
+	/// CONCURRENCY: Reclamation
+	/*! @brief Deleter of a retired object, called once no thread can reach it anymore.
+	 */
+	using __reclaim_fun_t = void (*)(void *);
+
+	/// CONCURRENCY: Reclamation -> Hazard Pointers
+	pf_decl_constexpr uint32_t CCY_HAZARD_NUM_SLOTS = 8;	// Per thread
+
+	struct __hazard_record_t
+	{
+		pf_alignas(CCY_ALIGN) atomic<void *> slots[CCY_HAZARD_NUM_SLOTS];
+		pf_alignas(CCY_ALIGN) atomic<bool> active;
+		uint32_t used;	// Slots owned by hazard pointers, only touched by its thread
+		__hazard_record_t *next;
+	};
+	pf_hint_nodiscard pulsar_api __hazard_record_t *
+	__hazard_this_record();
+	pf_hint_nodiscard pulsar_api atomic<void *> *
+	__hazard_acquire_slot();
+	pulsar_api void
+	__hazard_retire(
+	 void *__ptr,
+	 __reclaim_fun_t __fun);
+
+	/*! @brief Frees the objects this thread retired that no hazard pointer protects anymore.
+	 *				 Called by hazard_retire once enough of them are pending.
+	 */
+	pulsar_api void
+	hazard_reclaim();
+	pf_hint_nodiscard pulsar_api size_t
+	hazard_num_retired() pf_attr_noexcept;
+
+	/*! @brief Owns one of the CCY_HAZARD_NUM_SLOTS slots of this thread, an object it protects
+	 *				 won't be freed by the threads retiring it until it's reset or the pointer destroyed.
+	 *				 Throws when all the slots of this thread are in use.
+	 */
+	class hazard_pointer pf_attr_final
+	{
+	public:
+		/// Constructors
+		hazard_pointer()
+			: slot_(__hazard_acquire_slot())
+		{}
+		hazard_pointer(hazard_pointer const &) = delete;
+		hazard_pointer(hazard_pointer &&)			 = delete;
+
+		/// Destructor
+		~hazard_pointer() pf_attr_noexcept
+		{
+			this->slot_->store(nullptr, atomic_order::release);
+			__hazard_record_t *r = __hazard_this_record();
+			r->used &= ~(1u << static_cast<uint32_t>(this->slot_ - &r->slots[0]));
+		}
+
+		/// Operator =
+		hazard_pointer &
+		operator=(hazard_pointer const &) = delete;
+		hazard_pointer &
+		operator=(hazard_pointer &&) = delete;
+
+		/// Protect
+		/*! @brief Publishes the pointer __src holds, reloading it until it didn't change meanwhile.
+		 */
+		template<typename _Ty>
+		pf_hint_nodiscard _Ty *
+		protect(
+		 atomic<_Ty *> const &__src) pf_attr_noexcept
+		{
+			_Ty *p = __src.load(atomic_order::relaxed);
+			while(true)
+			{
+				this->slot_->store(p, atomic_order::seq_cst);
+				_Ty *v = __src.load(atomic_order::seq_cst);
+				if(v == p) return p;
+				p = v;
+			}
+		}
+		template<typename _Ty>
+		pf_hint_nodiscard bool
+		try_protect(
+		 _Ty *&__p,
+		 atomic<_Ty *> const &__src) pf_attr_noexcept
+		{
+			this->slot_->store(__p, atomic_order::seq_cst);
+			_Ty *v = __src.load(atomic_order::seq_cst);
+			if(v == __p) return true;
+			this->slot_->store(nullptr, atomic_order::release);
+			__p = v;
+			return false;
+		}
+
+		/// Reset
+		void
+		reset(
+		 void *__p = nullptr) pf_attr_noexcept
+		{
+			this->slot_->store(__p, atomic_order::seq_cst);
+		}
+
+		/// Valid
+		pf_hint_nodiscard bool
+		is_valid() const pf_attr_noexcept
+		{
+			return this->slot_ != nullptr;
+		}
+
+	private:
+		/// Store
+		atomic<void *> *slot_;
+	};
+
+	/*! @brief Hands __p over to the reclamation layer, _DeleterTy()(__p) is called once no hazard pointer protects it.
+	 *				 __p must be unreachable from the shared structure already.
+	 */
+	template<
+	 typename _Ty,
+	 typename _DeleterTy>
+	pf_decl_inline void
+	hazard_retire(
+	 _Ty *__p)
+	{
+		__hazard_retire(
+		 union_cast<void *>(__p),
+		 [](void *__q)
+		 { _DeleterTy()(union_cast<_Ty *>(__q)); });
+	}
+
+	/// CONCURRENCY: Reclamation -> Epochs
+	struct __epoch_record_t
+	{
+		pf_alignas(CCY_ALIGN) atomic<uint64_t> epoch;	 // (Global epoch << 1) | 1 while pinned, 0 when quiescent
+		pf_alignas(CCY_ALIGN) atomic<bool> active;
+		uint32_t nesting;
+		__epoch_record_t *next;
+	};
+	pf_hint_nodiscard pulsar_api __epoch_record_t *
+	__epoch_this_record();
+	pf_hint_nodiscard pulsar_api atomic<uint64_t> &
+	__epoch_global() pf_attr_noexcept;
+	pulsar_api void
+	__epoch_retire(
+	 void *__ptr,
+	 __reclaim_fun_t __fun);
+
+	/*! @brief Tries to advance the global epoch and frees the objects this thread retired two epochs ago.
+	 */
+	pulsar_api void
+	epoch_reclaim();
+	/*! @brief Waits until every thread pinned when it was called has left its guard. Must not be called under a guard.
+	 */
+	pulsar_api void
+	epoch_synchronize();
+	pf_hint_nodiscard pulsar_api size_t
+	epoch_num_retired() pf_attr_noexcept;
+
+	/*! @brief Pins the calling thread to the current epoch while it lives, guards nest. Objects reachable
+	 *				 when the guard was taken stay valid until it's destroyed, whoever retires them.
+	 */
+	class epoch_guard pf_attr_final
+	{
+	public:
+		/// Constructors
+		epoch_guard()
+			: record_(__epoch_this_record())
+		{
+			if(this->record_->nesting++ == 0)
+			{
+				this->record_->epoch.store((__epoch_global().load(atomic_order::seq_cst) << 1) | 1, atomic_order::seq_cst);
+			}
+		}
+		epoch_guard(epoch_guard const &) = delete;
+		epoch_guard(epoch_guard &&)			 = delete;
+
+		/// Destructor
+		~epoch_guard() pf_attr_noexcept
+		{
+			if(--this->record_->nesting == 0) this->record_->epoch.store(0, atomic_order::release);
+		}
+
+		/// Operator =
+		epoch_guard &
+		operator=(epoch_guard const &) = delete;
+		epoch_guard &
+		operator=(epoch_guard &&) = delete;
+
+	private:
+		/// Store
+		__epoch_record_t *record_;
+	};
+
+	/*! @brief Hands __p over to the reclamation layer, _DeleterTy()(__p) is called once every thread
+	 *				 pinned when it was retired has left its guard. __p must be unreachable from the shared structure already.
+	 */
+	template<
+	 typename _Ty,
+	 typename _DeleterTy>
+	pf_decl_inline void
+	epoch_retire(
+	 _Ty *__p)
+	{
+		__epoch_retire(
+		 union_cast<void *>(__p),
+		 [](void *__q)
+		 { _DeleterTy()(union_cast<_Ty *>(__q)); });
+	}
 }	 // namespace pul
 
 #endif	// !PULSAR_CONCURRENCY_HPP
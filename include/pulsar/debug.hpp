@@ -572,6 +572,11 @@ namespace pul
 	/// DEBUG: Exception -> Record -> Make
 	pf_hint_nodiscard pulsar_api void *
 	__dbg_get_current_exception_record() pf_attr_noexcept;
+	pf_hint_nodiscard pulsar_api void *
+	__dbg_copy_current_exception_record() pf_attr_noexcept;
+	pulsar_api void
+	__dbg_delete_exception_record(
+	 void *__record) pf_attr_noexcept;
 	pulsar_api void
 	__dbg_set_current_exception_record(
 	 void *__record) pf_attr_noexcept;
@@ -583,6 +588,7 @@ namespace pul
 		/// Constructors
 		__dbg_exception_record_t() pf_attr_noexcept
 			: ptr_(nullptr)
+			, ctrl_(nullptr)
 			, record_(nullptr)
 		{}
 		__dbg_exception_record_t(__dbg_exception_record_t const &) = delete;
@@ -620,7 +626,9 @@ namespace pul
 		{
 			this->ptr_		= std::move(__ptr);
 			this->ctrl_		= __control;
-			this->record_ = __dbg_get_current_exception_record();
+			this->record_ = __control
+											? __dbg_get_current_exception_record()
+											: __dbg_copy_current_exception_record();	// NOTE: Nobody waits on the thrower, keep a copy
 		}
 
 	private:
@@ -18,6 +18,9 @@
 #include "pulsar/allocator.hpp"
 #include "pulsar/algorithm.hpp"
 
+// Include: C++
+#include <functional>	// std::hash, std::equal_to
+
 // Pulsar
 namespace pul
 {
@@ -585,6 +588,8 @@ namespace pul
 	// https://github.com/max0x7ba/atomic_queue/blob/master/include/atomic_queue/atomic_queue.h
 
 	/// QUEUE: MPMC
+	/*! @brief Slots aren't sequenced, a reader may reach one before its writer stored it. Prefer mpmc_ring.
+	 */
 	template<typename _Ty>
 	class mpmc_lifo
 	{
@@ -631,14 +636,14 @@ namespace pul
 			 _Ty *__p) pf_attr_noexcept
 			{
 				// Initialisation
-				size_t h = this->head.load(atomic_order::relaxed) % this->maxcount;
-				size_t t = this->tail.load(atomic_order::relaxed) % this->maxcount;
+				size_t h = this->head.load(atomic_order::relaxed);
+				size_t t = this->tail.load(atomic_order::relaxed);
 				size_t c = writers.fetch_add(1, atomic_order::relaxed);
 
-				// Verify
-				size_t d			 = h <= t ? this->maxcount - h + t : t - h;
+				// Verify -> Room for this writer and the ones in flight
+				const size_t d = this->maxcount - (t - h);
 				const size_t n = c + 1;
-				if((t + n % this->maxcount) > d)
+				if(n > d)
 				{
 					this->writers.fetch_sub(1, atomic_order::relaxed);
 					return false;
@@ -647,32 +652,32 @@ namespace pul
 				// Add
 				t = this->tail.fetch_add(1, atomic_order::relaxed);
 				this->writers.fetch_sub(1, atomic_order::relaxed);
-				t									= this->__shuffle(t);
+				t									= this->__shuffle(t % this->maxcount);
 				this->elements[t] = __p;
-				return false;
+				return true;
 			}
 			void
 			__enqueue(
 			 _Ty *__p)
 			{
 				// Add
-				size_t t													 = this->tail.fetch_add(1, atomic_order::relaxed);
-				this->elements[this->__shuffle(t)] = __p;
+				size_t t																							= this->tail.fetch_add(1, atomic_order::relaxed);
+				this->elements[this->__shuffle(t % this->maxcount)] = __p;
 			}
 
 			/// Dequeue
 			pf_hint_nodiscard _Ty *
 			__try_dequeue() pf_attr_noexcept
 			{
-				size_t h = this->head.load(atomic_order::relaxed) % this->maxcount;
-				size_t t = this->tail.load(atomic_order::relaxed) % this->maxcount;
+				size_t h = this->head.load(atomic_order::relaxed);
+				size_t t = this->tail.load(atomic_order::relaxed);
 				if(h == t) return nullptr;
 				size_t c = readers.fetch_add(1, atomic_order::relaxed);
 
-				// Verify
-				size_t d			 = h <= t ? t - h : this->maxcount - h + t;
+				// Verify -> An element for this reader and the ones in flight
+				const size_t d = t - h;
 				const size_t n = c + 1;
-				if((t + n % this->maxcount) > d)
+				if(n > d)
 				{
 					this->readers.fetch_sub(1, atomic_order::relaxed);
 					return nullptr;
@@ -681,7 +686,7 @@ namespace pul
 				// Add
 				h = this->head.fetch_add(1, atomic_order::relaxed);
 				this->readers.fetch_sub(1, atomic_order::relaxed);
-				h = this->__shuffle(h);
+				h = this->__shuffle(h % this->maxcount);
 				return this->elements[h];
 			}
 
@@ -799,69 +804,44 @@ namespace pul
 		__buffer_t *buf_;
 	};
 
-
-	/// QUEUE: MPMC 2 (Multi-CAS)
+	/// QUEUE: MPMC Ring (Vyukov)
+	/*! @brief Bounded FIFO, every cell carries a sequence number telling which lap may write or read it next.
+	 *				 A producer (resp. consumer) claims a position with a single CAS on tail (resp. head), then
+	 *				 publishes the cell with a release store of its sequence.
+	 */
 	template<typename _Ty>
-	class mpmc_lifo2
+	class mpmc_ring
 	{
 	private:
-		/// Type -> Header
-		struct __header_t
+		/// Type -> Cell
+		struct __cell_t
 		{
-			/// Constructors
-			__header_t() pf_attr_noexcept
-				: head(0)
-				, writer(0)
-				, tail(0)
-			{}
-			__header_t(__header_t const &) = delete;
-			__header_t(__header_t &&)			 = delete;
-
-			/// Destructor
-			~__header_t() pf_attr_noexcept = default;
-
-			/// Operator =
-			__header_t &
-			operator=(__header_t const &) = delete;
-			__header_t &
-			operator=(__header_t &&) = delete;
-
-			/// Store
-			pf_alignas(CCY_ALIGN) atomic<uint32_t> head;
-			pf_alignas(CCY_ALIGN) atomic<uint32_t> writer;
-			pf_alignas(CCY_ALIGN) atomic<uint32_t> tail;
+			atomic<size_t> seq;
+			_Ty *data;
 		};
 
-		// [b ][H1][H2][..][HN][L1][L2][..][LN]
-
 		/// Type -> Buffer
 		struct __buffer_t
 		{
 			/// Constructors
 			__buffer_t(
-			 size_t __seqcount) pf_attr_noexcept
-				: seqcount(__seqcount)
+			 size_t __maxcount) pf_attr_noexcept
+				: head(0)
+				, tail(0)
+				, mask(__maxcount - 1)
 			{
-				pf_assert(this->seqcount > CCY_NUM_THREADS * 64, "seqcount_ must be greater than {}. seqcount_={}", CCY_NUM_THREADS * 64, this->seqcount);
-
-				// Construct Headers
-				for(uint32_t i = 0; i < CCY_NUM_THREADS; ++i)
+				pf_assert(is_power_of_two(__maxcount), "maxcount must be a power of two!");
+				for(size_t i = 0; i != __maxcount; ++i)
 				{
-					construct(this->__get_header(i));
+					construct(&this->cells[i].seq, i);
+					this->cells[i].data = nullptr;
 				}
 			}
 			__buffer_t(__buffer_t const &) = delete;
 			__buffer_t(__buffer_t &&)			 = delete;
 
 			/// Destructor
-			~__buffer_t() pf_attr_noexcept
-			{
-				// Destroy Headers
-				for(uint32_t i = 0; i < CCY_NUM_THREADS; ++i)
-				{
-					destroy(this->__get_header(i));
-				}
-			}
+			~__buffer_t() pf_attr_noexcept = default;
 
 			/// Operator =
 			__buffer_t &
@@ -869,151 +849,130 @@ namespace pul
 			__buffer_t &
 			operator=(__buffer_t &&) = delete;
 
-			/// Get Header
-			pf_hint_nodiscard pf_decl_inline __header_t *
-			__get_header(
-			 uint32_t __k) pf_attr_noexcept
-			{
-				return union_cast<__header_t *>(
-				 &this->store[0] + __k * sizeof(__header_t));
-			}
-
-			/// Get list
-			pf_hint_nodiscard pf_decl_inline _Ty **
-			__get_list(
-			 uint32_t __k) pf_attr_noexcept
-			{
-				return union_cast<_Ty **>(
-				 &this->store[0] + CCY_NUM_THREADS * sizeof(__header_t) + __k * this->seqcount * sizeof(_Ty *));
-			}
-
 			/// Enqueue
-			size_t
+			pf_hint_nodiscard bool
 			__try_enqueue(
-			 _Ty *__ptr) pf_attr_noexcept
+			 _Ty *__p) pf_attr_noexcept
 			{
-				const thread_id_t idx = this_thread::get_idx();
-				uint32_t i						= idx;
-				do {
-					__header_t *c		 = this->__get_header(i);
-					const uint32_t h = c->head.load(atomic_order::acquire);
-					uint32_t t			 = c->tail.load(atomic_order::acquire);
-					if(t == h - 1 || !c->tail.compare_exchange_strong(t, t + 1, atomic_order::release, atomic_order::relaxed))
+				size_t pos = this->tail.load(atomic_order::relaxed);
+				__cell_t *c;
+				while(true)
+				{
+					c							 = &this->cells[pos & this->mask];
+					const diff_t d = union_cast<diff_t>(c->seq.load(atomic_order::acquire) - pos);
+					if(d == 0)
 					{
-						i = (i + 1) % CCY_NUM_THREADS;
+						if(this->tail.compare_exchange_weak(pos, pos + 1, atomic_order::relaxed, atomic_order::relaxed)) break;
+					}
+					else if(d < 0)
+					{
+						return false;	 // Full
 					}
 					else
 					{
-						auto l								= this->__get_list(i);
-						l[t % this->seqcount] = __ptr;
-						c->writer.fetch_add(1, atomic_order::relaxed);
-						return 1;
+						pos = this->tail.load(atomic_order::relaxed);
 					}
-				} while(i != idx);
-				return 0;
+				}
+				c->data = __p;
+				c->seq.store(pos + 1, atomic_order::release);
+				return true;
 			}
-			template<typename _IteratorIn>
-			size_t
+			pf_hint_nodiscard size_t
 			__try_enqueue_bulk(
-			 _IteratorIn __beg,
-			 _IteratorIn __end) pf_attr_noexcept
-				requires(is_iterator_v<_IteratorIn> && std::is_same_v<value_type_t<_IteratorIn>, _Ty *>)
+			 _Ty **__beg,
+			 _Ty **__end) pf_attr_noexcept
 			{
-				const uint32_t count = countof(__beg, __end);
-				if(pf_unlikely(count == 0 || count > this->seqcount)) return 0;
-				const thread_id_t idx = this_thread::get_idx();
-				uint32_t i						= idx;
-				do {
-					__header_t *c		 = this->__get_header(i);
-					const uint32_t h = c->head.load(atomic_order::acquire);
-					uint32_t t			 = c->tail.load(atomic_order::acquire);
-					const uint32_t n = (t + count);
-					if((n > h - 1 && n > union_cast<uint32_t>(-1) - count) || !c->tail.compare_exchange_strong(t, t + count, atomic_order::release, atomic_order::relaxed))
-					{
-						i = (i + 1) % CCY_NUM_THREADS;
-					}
-					else
+				const size_t m = countof(__beg, __end);
+				size_t pos		 = this->tail.load(atomic_order::relaxed);
+				size_t n;
+				while(true)
+				{
+					// Free cells following pos, a cell is free for this lap when its sequence is its position
+					n = 0;
+					while(n != m && this->cells[(pos + n) & this->mask].seq.load(atomic_order::acquire) == pos + n) ++n;
+					if(n == 0)
 					{
-						auto l = this->__get_list(i);
-						for(uint32_t k = 0; k < count; ++k)
-						{
-							l[(t + k) % this->seqcount] = __beg[k];
-						}
-						c->writer.fetch_add(count, atomic_order::relaxed);
-						return count;
+						const size_t s = this->cells[pos & this->mask].seq.load(atomic_order::relaxed);
+						if(union_cast<diff_t>(s - pos) < 0) return 0;	 // Full
+						pos = this->tail.load(atomic_order::relaxed);
+						continue;
 					}
-				} while(i != idx);
-				return 0;
+					if(this->tail.compare_exchange_weak(pos, pos + n, atomic_order::relaxed, atomic_order::relaxed)) break;
+				}
+				for(size_t i = 0; i != n; ++i)
+				{
+					__cell_t *c = &this->cells[(pos + i) & this->mask];
+					c->data			= __beg[i];
+					c->seq.store(pos + i + 1, atomic_order::release);
+				}
+				return n;
 			}
 
 			/// Dequeue
 			pf_hint_nodiscard _Ty *
 			__try_dequeue() pf_attr_noexcept
 			{
-				const thread_id_t idx = this_thread::get_idx();
-				uint32_t i						= idx;
-				do {
-					__header_t *c		 = this->__get_header(i);
-					uint32_t h			 = c->head.load(atomic_order::acquire);
-					const uint32_t t = c->writer.load(atomic_order::acquire);
-					if(h == t || !c->head.compare_exchange_strong(h, h + 1, atomic_order::release, atomic_order::relaxed))
+				size_t pos = this->head.load(atomic_order::relaxed);
+				__cell_t *c;
+				while(true)
+				{
+					c							 = &this->cells[pos & this->mask];
+					const diff_t d = union_cast<diff_t>(c->seq.load(atomic_order::acquire) - (pos + 1));
+					if(d == 0)
 					{
-						i = (i + 1) % CCY_NUM_THREADS;
+						if(this->head.compare_exchange_weak(pos, pos + 1, atomic_order::relaxed, atomic_order::relaxed)) break;
+					}
+					else if(d < 0)
+					{
+						return nullptr;	 // Empty
 					}
 					else
 					{
-						auto l = this->__get_list(i);
-						return l[h % this->seqcount];
+						pos = this->head.load(atomic_order::relaxed);
 					}
-				} while(i != idx);
-				return nullptr;
+				}
+				_Ty *p = c->data;
+				c->seq.store(pos + this->mask + 1, atomic_order::release);
+				return p;
 			}
-			template<typename _IteratorOut>
 			pf_hint_nodiscard size_t
 			__try_dequeue_bulk(
-			 _IteratorOut __beg,
-			 _IteratorOut __end) pf_attr_noexcept
-				requires(is_iterator_v<_IteratorOut> && std::is_same_v<value_type_t<_IteratorOut>, _Ty *>)
+			 _Ty **__beg,
+			 _Ty **__end) pf_attr_noexcept
 			{
-				const thread_id_t idx = this_thread::get_idx();
-				const uint32_t count	= union_cast<uint32_t>(countof(__beg, __end));
-				if(pf_unlikely(count == 0)) return 0;
-				uint32_t i = idx;
-				do {
-					__header_t *c						 = this->__get_header(i);
-					uint32_t h							 = c->head.load(atomic_order::acquire);
-					const uint32_t t				 = c->writer.load(atomic_order::acquire);
-					const uint32_t available = t - h;
-					uint32_t num						 = count > available ? available : count;
-					if(num == 0 || !c->head.compare_exchange_strong(h, h + num, atomic_order::release, atomic_order::relaxed))
-					{
-						i = (i + 1) % CCY_NUM_THREADS;
-					}
-					else
+				const size_t m = countof(__beg, __end);
+				size_t pos		 = this->head.load(atomic_order::relaxed);
+				size_t n;
+				while(true)
+				{
+					// Published cells following pos
+					n = 0;
+					while(n != m && this->cells[(pos + n) & this->mask].seq.load(atomic_order::acquire) == pos + n + 1) ++n;
+					if(n == 0)
 					{
-						auto l = this->__get_list(i);
-						for(size_t k = 0; k < num; ++k)
-						{
-							__beg[k] = l[(h + k) % this->seqcount];
-						}
-						return num;
+						const size_t s = this->cells[pos & this->mask].seq.load(atomic_order::relaxed);
+						if(union_cast<diff_t>(s - (pos + 1)) < 0) return 0;	// Empty
+						pos = this->head.load(atomic_order::relaxed);
+						continue;
 					}
-				} while(i != idx);
-				return 0;
+					if(this->head.compare_exchange_weak(pos, pos + n, atomic_order::relaxed, atomic_order::relaxed)) break;
+				}
+				for(size_t i = 0; i != n; ++i)
+				{
+					__cell_t *c = &this->cells[(pos + i) & this->mask];
+					__beg[i]		= c->data;
+					c->seq.store(pos + i + this->mask + 1, atomic_order::release);
+				}
+				return n;
 			}
 
-			/// Empty
-			pf_hint_nodiscard bool
-			__empty() const pf_attr_noexcept
+			/// Size
+			pf_hint_nodiscard size_t
+			__size() const pf_attr_noexcept
 			{
-				for(size_t i = 0; i < CCY_NUM_THREADS; ++i)
-				{
-					__header_t *c = this->__get_header(i);
-					uint32_t h		= c->head.load(atomic_order::acquire);
-					uint32_t t		= c->tail.load(atomic_order::acquire);
-					if(h != t) return false;
-				}
-				return true;
+				const size_t h = this->head.load(atomic_order::relaxed);
+				const size_t t = this->tail.load(atomic_order::relaxed);
+				return t > h ? t - h : 0;	 // NOTE: Approximate while producers or consumers run
 			}
 
 			/// Store
@@ -1021,8 +980,10 @@ namespace pul
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 
-			const size_t seqcount;
-			pf_alignas(CCY_ALIGN) byte_t store[];
+			pf_alignas(CCY_ALIGN) atomic<size_t> head;
+			pf_alignas(CCY_ALIGN) atomic<size_t> tail;
+			pf_alignas(CCY_ALIGN) const size_t mask;
+			pf_alignas(CCY_ALIGN) __cell_t cells[];
 
 			// Flexible Arrays
 #pragma GCC diagnostic pop
@@ -1031,11 +992,9 @@ namespace pul
 		/// Buffer -> New
 		pf_hint_nodiscard __buffer_t *
 		__new_buffer(
-		 size_t __seqcount) pf_attr_noexcept
+		 size_t __maxcount)
 		{
-			__buffer_t *b = new_construct_ex<__buffer_t>(CCY_NUM_THREADS * (sizeof(__header_t) + __seqcount * sizeof(_Ty *)), __seqcount);
-			std::memset(&b->store[0] + CCY_NUM_THREADS * sizeof(__header_t), 0, __seqcount * sizeof(_Ty *) * CCY_NUM_THREADS);
-			return b;
+			return new_construct_ex<__buffer_t>(sizeof(__cell_t) * __maxcount, __maxcount);
 		}
 
 		/// Buffer -> Delete
@@ -1043,98 +1002,1990 @@ namespace pul
 		__delete_buffer(
 		 __buffer_t *__buffer) pf_attr_noexcept
 		{
-			destroy_delete(__buffer);
+			if(__buffer) destroy_delete(__buffer);
 		}
 
 	public:
 		/// Constructors
-		pf_decl_inline
-		mpmc_lifo2(
-		 size_t __seqcount)
-			: buf_(this->__new_buffer(__seqcount))
-		{}
-		pf_decl_inline
-		mpmc_lifo2(
-		 mpmc_lifo2<_Ty> const &__other)
-			: buf_(this->__new_buffer(__other.buf_->seqcount))
+		mpmc_ring(
+		 size_t __maxcount)
+			: buf_(this->__new_buffer(__maxcount))
 		{}
-		pf_decl_inline
-		mpmc_lifo2(
-		 mpmc_lifo2<_Ty> &&__other)
+		mpmc_ring(mpmc_ring<_Ty> const &) = delete;
+		mpmc_ring(mpmc_ring<_Ty> &&__other) pf_attr_noexcept
 			: buf_(__other.buf_)
 		{
-			__other.buf_ = this->__new_buffer(__other.buf_->seqcount);
+			__other.buf_ = nullptr;
 		}
 
-		/// Operator =
-		pf_decl_inline mpmc_lifo2<_Ty> &
-		operator=(
-		 mpmc_lifo2<_Ty> const &__other)
+		/// Destructor
+		~mpmc_ring() pf_attr_noexcept
 		{
-			if(pf_likely(this != __other))
-			{
-				pf_assert(this->__empty(), "Deleting not empty buffer!");
-				this->__delete_buffer(this->buf_);
-				this->buf_ = this->__new_buffer(__other.buf_->seqcount);
-			}
-			return *this;
+			this->__delete_buffer(this->buf_);
 		}
-		pf_decl_inline mpmc_lifo2<_Ty> &
+
+		/// Operator =
+		mpmc_ring<_Ty> &
 		operator=(
-		 mpmc_lifo2<_Ty> &&__other)
+		 mpmc_ring<_Ty> const &) = delete;
+		mpmc_ring<_Ty> &
+		operator=(
+		 mpmc_ring<_Ty> &&__other) pf_attr_noexcept
 		{
-			if(pf_likely(this != __other))
+			if(pf_likely(this != &__other))
 			{
-				pf_assert(this->__empty(), "Deleting not empty buffer!");
+				pf_assert(this->empty(), "Deleting not empty buffer!");
 				this->__delete_buffer(this->buf_);
 				this->buf_	 = __other.buf_;
-				__other.buf_ = this->__new_buffer(__other.buf_->seqcount);
+				__other.buf_ = nullptr;
 			}
 			return *this;
 		}
 
-		/// Destructor
-		pf_decl_inline ~mpmc_lifo2() pf_attr_noexcept
-		{
-			this->__delete_buffer(this->buf_);
-		}
-
 		/// Enqueue
-		pf_decl_inline bool
+		pf_hint_nodiscard bool
 		try_enqueue(
-		 _Ty *__ptr) pf_attr_noexcept
+		 _Ty *__p) pf_attr_noexcept
 		{
-			return this->buf_->__try_enqueue(__ptr);
+			return this->buf_->__try_enqueue(__p);
 		}
-		template<typename _IteratorIn>
-		pf_decl_inline bool
+		pf_hint_nodiscard size_t
 		try_enqueue_bulk(
-		 _IteratorIn __beg,
-		 _IteratorIn __end) pf_attr_noexcept
-			requires(is_iterator_v<_IteratorIn> && std::is_same_v<value_type_t<_IteratorIn>, _Ty *>)
+		 _Ty **__beg,
+		 _Ty **__end) pf_attr_noexcept
 		{
 			return this->buf_->__try_enqueue_bulk(__beg, __end);
 		}
 
 		/// Dequeue
-		pf_hint_nodiscard pf_decl_inline _Ty *
+		pf_hint_nodiscard _Ty *
 		try_dequeue() pf_attr_noexcept
 		{
 			return this->buf_->__try_dequeue();
 		}
-		template<typename _IteratorOut>
-		pf_hint_nodiscard pf_decl_inline size_t
+		pf_hint_nodiscard size_t
 		try_dequeue_bulk(
-		 _IteratorOut __beg,
-		 _IteratorOut __end) pf_attr_noexcept
-			requires(is_iterator_v<_IteratorOut> && std::is_same_v<value_type_t<_IteratorOut>, _Ty *>)
+		 _Ty **__beg,
+		 _Ty **__end) pf_attr_noexcept
 		{
 			return this->buf_->__try_dequeue_bulk(__beg, __end);
 		}
 
-	private:
-		/// Store
-		__buffer_t *buf_;
+		/// Size
+		pf_hint_nodiscard size_t
+		size() const pf_attr_noexcept
+		{
+			return this->buf_->__size();
+		}
+		pf_hint_nodiscard size_t
+		capacity() const pf_attr_noexcept
+		{
+			return this->buf_->mask + 1;
+		}
+
+		/// Empty
+		pf_hint_nodiscard bool
+		empty() const pf_attr_noexcept
+		{
+			return this->buf_->__size() == 0;
+		}
+
+	private:
+		// Store
+		__buffer_t *buf_;
+	};
+
+	/// QUEUE: SPSC Ring
+	/*! @brief Bounded FIFO for exactly one producer and one consumer, values are stored inline.
+	 *				 Each side keeps a local copy of the other side's index and only reloads it when the ring
+	 *				 looks full (resp. empty), so both cache lines stay owned by their thread in steady state.
+	 */
+	template<typename _Ty>
+	class spsc_ring
+	{
+	public:
+		/// Type -> Window
+		struct window_t
+		{
+			_Ty *data;
+			size_t count;
+		};
+
+	private:
+		/// Type -> Buffer
+		struct __buffer_t
+		{
+			/// Constructors
+			__buffer_t(
+			 size_t __maxcount) pf_attr_noexcept
+				: tail(0)
+				, headCache(0)
+				, head(0)
+				, tailCache(0)
+				, mask(__maxcount - 1)
+			{
+				pf_assert(is_power_of_two(__maxcount), "maxcount must be a power of two!");
+			}
+			__buffer_t(__buffer_t const &) = delete;
+			__buffer_t(__buffer_t &&)			 = delete;
+
+			/// Destructor
+			~__buffer_t() pf_attr_noexcept
+			{
+				const size_t t = this->tail.load(atomic_order::acquire);
+				for(size_t h = this->head.load(atomic_order::relaxed); h != t; ++h) destroy(this->__at(h));
+			}
+
+			/// Operator =
+			__buffer_t &
+			operator=(__buffer_t const &) = delete;
+			__buffer_t &
+			operator=(__buffer_t &&) = delete;
+
+			/// At
+			pf_hint_nodiscard pf_decl_inline _Ty *
+			__at(
+			 size_t __index) pf_attr_noexcept
+			{
+				return union_cast<_Ty *>(&this->store[0]) + (__index & this->mask);
+			}
+
+			/// Producer -> Free
+			pf_hint_nodiscard pf_decl_inline size_t
+			__num_free(
+			 size_t __t,
+			 size_t __n) pf_attr_noexcept
+			{
+				size_t f = this->mask + 1 - (__t - this->headCache);
+				if(f < __n)
+				{
+					this->headCache = this->head.load(atomic_order::acquire);
+					f								= this->mask + 1 - (__t - this->headCache);
+				}
+				return f;
+			}
+
+			/// Consumer -> Available
+			pf_hint_nodiscard pf_decl_inline size_t
+			__num_available(
+			 size_t __h,
+			 size_t __n) pf_attr_noexcept
+			{
+				size_t a = this->tailCache - __h;
+				if(a < __n)
+				{
+					this->tailCache = this->tail.load(atomic_order::acquire);
+					a								= this->tailCache - __h;
+				}
+				return a;
+			}
+
+			/// Push
+			template<typename... _Args>
+			pf_hint_nodiscard bool
+			__try_emplace(
+			 _Args &&...__args)
+			{
+				const size_t t = this->tail.load(atomic_order::relaxed);
+				if(this->__num_free(t, 1) == 0) return false;
+				construct(this->__at(t), std::forward<_Args>(__args)...);
+				this->tail.store(t + 1, atomic_order::release);
+				return true;
+			}
+			pf_hint_nodiscard size_t
+			__try_push_n(
+			 _Ty const *__beg,
+			 size_t __n)
+			{
+				const size_t t = this->tail.load(atomic_order::relaxed);
+				const size_t n = std::min(__n, this->__num_free(t, __n));
+				for(size_t i = 0; i != n; ++i) construct(this->__at(t + i), __beg[i]);
+				this->tail.store(t + n, atomic_order::release);	 // NOTE: One publication for the whole batch
+				return n;
+			}
+
+			/// Pop
+			pf_hint_nodiscard bool
+			__try_pop(
+			 _Ty &__out)
+			{
+				const size_t h = this->head.load(atomic_order::relaxed);
+				if(this->__num_available(h, 1) == 0) return false;
+				_Ty *p = this->__at(h);
+				__out	 = std::move(*p);
+				destroy(p);
+				this->head.store(h + 1, atomic_order::release);
+				return true;
+			}
+			pf_hint_nodiscard size_t
+			__try_pop_n(
+			 _Ty *__beg,
+			 size_t __n)
+			{
+				const size_t h = this->head.load(atomic_order::relaxed);
+				const size_t n = std::min(__n, this->__num_available(h, __n));
+				for(size_t i = 0; i != n; ++i)
+				{
+					_Ty *p	 = this->__at(h + i);
+					__beg[i] = std::move(*p);
+					destroy(p);
+				}
+				this->head.store(h + n, atomic_order::release);
+				return n;
+			}
+
+			/// Windows
+			pf_hint_nodiscard window_t
+			__reserve(
+			 size_t __n) pf_attr_noexcept
+			{
+				const size_t t = this->tail.load(atomic_order::relaxed);
+				const size_t e = this->mask + 1 - (t & this->mask);	 // NOTE: Contiguous up to the end of the buffer
+				return { this->__at(t), std::min({ __n, e, this->__num_free(t, std::min(__n, e)) }) };
+			}
+			void
+			__commit(
+			 size_t __n) pf_attr_noexcept
+			{
+				this->tail.store(this->tail.load(atomic_order::relaxed) + __n, atomic_order::release);
+			}
+			pf_hint_nodiscard window_t
+			__peek(
+			 size_t __n) pf_attr_noexcept
+			{
+				const size_t h = this->head.load(atomic_order::relaxed);
+				const size_t e = this->mask + 1 - (h & this->mask);
+				return { this->__at(h), std::min({ __n, e, this->__num_available(h, std::min(__n, e)) }) };
+			}
+			void
+			__consume(
+			 size_t __n) pf_attr_noexcept
+			{
+				this->head.store(this->head.load(atomic_order::relaxed) + __n, atomic_order::release);
+			}
+
+			/// Size
+			pf_hint_nodiscard size_t
+			__size() const pf_attr_noexcept
+			{
+				return this->tail.load(atomic_order::acquire) - this->head.load(atomic_order::acquire);
+			}
+
+			/// Store
+			// Flexible Arrays -> Disable warning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+			pf_alignas(CCY_ALIGN) atomic<size_t> tail;	// Producer line
+			size_t headCache;
+			pf_alignas(CCY_ALIGN) atomic<size_t> head;	// Consumer line
+			size_t tailCache;
+			pf_alignas(CCY_ALIGN) const size_t mask;
+			pf_alignas(CCY_ALIGN) byte_t store[];
+
+			// Flexible Arrays
+#pragma GCC diagnostic pop
+		};
+
+		/// Buffer -> New
+		pf_hint_nodiscard __buffer_t *
+		__new_buffer(
+		 size_t __maxcount)
+		{
+			return new_construct_ex<__buffer_t>(sizeof(_Ty) * __maxcount, __maxcount);
+		}
+
+		/// Buffer -> Delete
+		void
+		__delete_buffer(
+		 __buffer_t *__buffer) pf_attr_noexcept
+		{
+			if(__buffer) destroy_delete(__buffer);
+		}
+
+	public:
+		/// Constructors
+		spsc_ring(
+		 size_t __maxcount)
+			: buf_(this->__new_buffer(__maxcount))
+		{}
+		spsc_ring(spsc_ring<_Ty> const &) = delete;
+		spsc_ring(spsc_ring<_Ty> &&__other) pf_attr_noexcept
+			: buf_(__other.buf_)
+		{
+			__other.buf_ = nullptr;
+		}
+
+		/// Destructor
+		~spsc_ring() pf_attr_noexcept
+		{
+			this->__delete_buffer(this->buf_);
+		}
+
+		/// Operator =
+		spsc_ring<_Ty> &
+		operator=(
+		 spsc_ring<_Ty> const &) = delete;
+		spsc_ring<_Ty> &
+		operator=(
+		 spsc_ring<_Ty> &&__other) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__other))
+			{
+				this->__delete_buffer(this->buf_);
+				this->buf_	 = __other.buf_;
+				__other.buf_ = nullptr;
+			}
+			return *this;
+		}
+
+		/// Push (Producer)
+		pf_hint_nodiscard bool
+		try_push(
+		 _Ty const &__val)
+		{
+			return this->buf_->__try_emplace(__val);
+		}
+		pf_hint_nodiscard bool
+		try_push(
+		 _Ty &&__val)
+		{
+			return this->buf_->__try_emplace(std::move(__val));
+		}
+		template<typename... _Args>
+		pf_hint_nodiscard bool
+		try_emplace(
+		 _Args &&...__args)
+			requires(std::is_constructible_v<_Ty, _Args...>)
+		{
+			return this->buf_->__try_emplace(std::forward<_Args>(__args)...);
+		}
+		pf_hint_nodiscard size_t
+		try_push_n(
+		 _Ty const *__beg,
+		 size_t __n)
+		{
+			return this->buf_->__try_push_n(__beg, __n);
+		}
+
+		/// Pop (Consumer)
+		pf_hint_nodiscard bool
+		try_pop(
+		 _Ty &__out)
+		{
+			return this->buf_->__try_pop(__out);
+		}
+		pf_hint_nodiscard size_t
+		try_pop_n(
+		 _Ty *__beg,
+		 size_t __n)
+		{
+			return this->buf_->__try_pop_n(__beg, __n);
+		}
+
+		/// Windows
+		/*! @brief Zero-copy writes: reserve() returns up to __n contiguous free slots, the producer fills
+		 *				 them in place and commit() publishes the first ones it wrote. Reads mirror it with peek() and consume().
+		 */
+		pf_hint_nodiscard window_t
+		reserve(
+		 size_t __n) pf_attr_noexcept
+			requires(std::is_trivially_copyable_v<_Ty>)
+		{
+			return this->buf_->__reserve(__n);
+		}
+		void
+		commit(
+		 size_t __n) pf_attr_noexcept
+			requires(std::is_trivially_copyable_v<_Ty>)
+		{
+			this->buf_->__commit(__n);
+		}
+		pf_hint_nodiscard window_t
+		peek(
+		 size_t __n) pf_attr_noexcept
+			requires(std::is_trivially_copyable_v<_Ty>)
+		{
+			return this->buf_->__peek(__n);
+		}
+		void
+		consume(
+		 size_t __n) pf_attr_noexcept
+			requires(std::is_trivially_copyable_v<_Ty>)
+		{
+			this->buf_->__consume(__n);
+		}
+
+		/// Size
+		pf_hint_nodiscard size_t
+		size() const pf_attr_noexcept
+		{
+			return this->buf_->__size();
+		}
+		pf_hint_nodiscard size_t
+		capacity() const pf_attr_noexcept
+		{
+			return this->buf_->mask + 1;
+		}
+
+		/// Empty
+		pf_hint_nodiscard bool
+		empty() const pf_attr_noexcept
+		{
+			return this->buf_->__size() == 0;
+		}
+
+	private:
+		// Store
+		__buffer_t *buf_;
+	};
+
+	/// QUEUE: MPMC Segmented
+	/*! @brief Unbounded FIFO made of linked segments of SEGMENT_SIZE cells, indices are claimed with a single
+	 *				 fetch_add (FAA array queue). Segments the head moved past are retired, then recycled through a
+	 *				 bounded pool once no thread holds them; beyond the pool they are freed, so memory shrinks after a burst.
+	 */
+	template<typename _Ty>
+	class mpmc_segmented_fifo
+	{
+	public:
+		pf_decl_static pf_decl_constexpr uint32_t SEGMENT_SIZE = 1'024;
+
+	private:
+		/// Type -> Segment
+		struct __segment_t
+		{
+			/// Reset
+			void
+			__reset() pf_attr_noexcept
+			{
+				this->deqidx.store(0, atomic_order::relaxed);
+				this->enqidx.store(0, atomic_order::relaxed);
+				this->next.store(nullptr, atomic_order::relaxed);
+				this->retired = nullptr;
+				for(uint32_t i = 0; i != SEGMENT_SIZE; ++i) this->items[i].store(nullptr, atomic_order::relaxed);
+			}
+
+			/// Store
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> deqidx;
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> enqidx;
+			pf_alignas(CCY_ALIGN) atomic<__segment_t *> next;
+			__segment_t *retired;
+			atomic<_Ty *> items[SEGMENT_SIZE];
+		};
+
+		/// Type -> Hazard
+		struct __hazard_t
+		{
+			pf_alignas(CCY_ALIGN) atomic<__segment_t *> seg = nullptr;	// NOTE: Non-null while a thread owns the slot
+		};
+
+		/// Hazard -> Protect
+		pf_hint_nodiscard __hazard_t *
+		__protect(
+		 atomic<__segment_t *> &__src,
+		 __segment_t *&__seg) pf_attr_noexcept
+		{
+			// Claim -> Probing from this thread's index, usually its own slot
+			__segment_t *s = __src.load(atomic_order::acquire);
+			__hazard_t *h	 = nullptr;
+			for(size_t i = this_thread::get_idx();; ++i)
+			{
+				__hazard_t *c = &this->hazards_[i % this->numHazards_];
+				__segment_t *e = nullptr;
+				if(c->seg.compare_exchange_strong(e, s, atomic_order::seq_cst, atomic_order::relaxed))
+				{
+					h = c;
+					break;
+				}
+			}
+
+			// Verify -> The segment mustn't have been retired before it was published
+			while(true)
+			{
+				__segment_t *v = __src.load(atomic_order::seq_cst);
+				if(v == s) break;
+				h->seg.store(v, atomic_order::seq_cst);
+				s = v;
+			}
+			__seg = s;
+			return h;
+		}
+		pf_hint_nodiscard bool
+		__is_protected(
+		 __segment_t *__seg) const pf_attr_noexcept
+		{
+			for(size_t i = 0; i != this->numHazards_; ++i)
+			{
+				if(this->hazards_[i].seg.load(atomic_order::seq_cst) == __seg) return true;
+			}
+			return false;
+		}
+
+		/// Segments -> Pool
+		pf_hint_nodiscard __segment_t *
+		__acquire_segment()
+		{
+			__segment_t *s = this->pool_.try_dequeue();
+			if(!s)
+			{
+				this->__reclaim();
+				s = this->pool_.try_dequeue();
+			}
+			if(!s)
+			{
+				s = new_construct<__segment_t>();
+				this->numSegments_.fetch_add(1, atomic_order::relaxed);
+			}
+			s->__reset();
+			return s;
+		}
+		void
+		__release_segment(
+		 __segment_t *__seg) pf_attr_noexcept
+		{
+			if(this->pool_.try_enqueue(__seg)) return;
+			destroy_delete(__seg);	// NOTE: Pool full, shrinks back
+			this->numSegments_.fetch_sub(1, atomic_order::relaxed);
+		}
+
+		/// Segments -> Retire
+		void
+		__retire(
+		 __segment_t *__seg) pf_attr_noexcept
+		{
+			__seg->retired = this->retired_.load(atomic_order::relaxed);
+			while(!this->retired_.compare_exchange_weak(__seg->retired, __seg, atomic_order::release, atomic_order::relaxed))
+				;
+			this->__reclaim();
+		}
+		void
+		__reclaim() pf_attr_noexcept
+		{
+			__segment_t *r = this->retired_.exchange(nullptr, atomic_order::acquire);
+			std::atomic_thread_fence(atomic_order::seq_cst);
+			while(r)
+			{
+				__segment_t *x = r->retired;
+				if(this->__is_protected(r))
+				{
+					r->retired = this->retired_.load(atomic_order::relaxed);
+					while(!this->retired_.compare_exchange_weak(r->retired, r, atomic_order::release, atomic_order::relaxed))
+						;
+				}
+				else
+				{
+					this->__release_segment(r);
+				}
+				r = x;
+			}
+		}
+
+	public:
+		/// Constructors
+		mpmc_segmented_fifo(
+		 size_t __maxPooled = 16)
+			: head_(nullptr)
+			, tail_(nullptr)
+			, retired_(nullptr)
+			, numSegments_(1)
+			, pool_(__pool_size(__maxPooled))
+			, numHazards_(2 * CCY_NUM_THREADS)
+			, hazards_(new_construct<__hazard_t[]>(2 * CCY_NUM_THREADS))
+		{
+			__segment_t *s = new_construct<__segment_t>();
+			s->__reset();
+			this->head_.store(s, atomic_order::relaxed);
+			this->tail_.store(s, atomic_order::relaxed);
+		}
+		mpmc_segmented_fifo(mpmc_segmented_fifo<_Ty> const &) = delete;
+		mpmc_segmented_fifo(mpmc_segmented_fifo<_Ty> &&)			 = delete;
+
+		/// Destructor
+		~mpmc_segmented_fifo() pf_attr_noexcept
+		{
+			__segment_t *s = this->head_.load(atomic_order::acquire);
+			while(s)
+			{
+				__segment_t *x = s->next.load(atomic_order::relaxed);
+				destroy_delete(s);
+				s = x;
+			}
+			s = this->retired_.load(atomic_order::acquire);
+			while(s)
+			{
+				__segment_t *x = s->retired;
+				destroy_delete(s);
+				s = x;
+			}
+			while((s = this->pool_.try_dequeue())) destroy_delete(s);
+			destroy_delete<__hazard_t[]>(this->hazards_);
+		}
+
+		/// Operator =
+		mpmc_segmented_fifo<_Ty> &
+		operator=(mpmc_segmented_fifo<_Ty> const &) = delete;
+		mpmc_segmented_fifo<_Ty> &
+		operator=(mpmc_segmented_fifo<_Ty> &&) = delete;
+
+		/// Enqueue
+		void
+		enqueue(
+		 _Ty *__p)
+		{
+			pf_assert(__p != nullptr, "Null elements can't be enqueued!");
+			__segment_t *s;
+			__hazard_t *h = this->__protect(this->tail_, s);
+			while(true)
+			{
+				const uint32_t i = s->enqidx.fetch_add(1, atomic_order::relaxed);
+				if(i < SEGMENT_SIZE)
+				{
+					_Ty *e = nullptr;
+					if(s->items[i].compare_exchange_strong(e, __p, atomic_order::release, atomic_order::relaxed)) break;
+					continue;	 // NOTE: A consumer gave up on this cell, take the next one
+				}
+
+				// Full -> Link a new segment, or help the one linking it
+				__segment_t *n = s->next.load(atomic_order::acquire);
+				if(!n)
+				{
+					__segment_t *g = this->__acquire_segment();
+					g->enqidx.store(1, atomic_order::relaxed);
+					g->items[0].store(__p, atomic_order::relaxed);
+					if(s->next.compare_exchange_strong(n, g, atomic_order::release, atomic_order::acquire))
+					{
+						this->tail_.compare_exchange_strong(s, g, atomic_order::seq_cst, atomic_order::relaxed);
+						break;
+					}
+					this->__release_segment(g);	// NOTE: Never published
+				}
+				this->tail_.compare_exchange_strong(s, n, atomic_order::seq_cst, atomic_order::relaxed);
+				h->seg.store(nullptr, atomic_order::release);
+				h = this->__protect(this->tail_, s);
+			}
+			h->seg.store(nullptr, atomic_order::release);
+		}
+
+		/// Dequeue
+		pf_hint_nodiscard _Ty *
+		try_dequeue() pf_attr_noexcept
+		{
+			__segment_t *s;
+			__hazard_t *h = this->__protect(this->head_, s);
+			_Ty *p				= nullptr;
+			while(true)
+			{
+				// Empty
+				if(s->deqidx.load(atomic_order::relaxed) >= s->enqidx.load(atomic_order::relaxed)
+					 && !s->next.load(atomic_order::acquire)) break;
+
+				const uint32_t i = s->deqidx.fetch_add(1, atomic_order::relaxed);
+				if(i < SEGMENT_SIZE)
+				{
+					p = s->items[i].exchange(__taken(), atomic_order::acquire);
+					if(p) break;
+					continue;	 // NOTE: Its producer is late, the cell is burnt
+				}
+
+				// Drained -> Move the head, the winner retires the segment
+				__segment_t *n = s->next.load(atomic_order::acquire);
+				if(!n) break;
+				if(this->head_.compare_exchange_strong(s, n, atomic_order::seq_cst, atomic_order::relaxed))
+				{
+					h->seg.store(nullptr, atomic_order::seq_cst);
+					this->__retire(s);
+				}
+				else
+				{
+					h->seg.store(nullptr, atomic_order::release);
+				}
+				h = this->__protect(this->head_, s);
+			}
+			h->seg.store(nullptr, atomic_order::release);
+			return p;
+		}
+
+		/// Empty
+		pf_hint_nodiscard bool
+		empty() const pf_attr_noexcept
+		{
+			__segment_t *s = this->head_.load(atomic_order::acquire);
+			return s->deqidx.load(atomic_order::relaxed) >= s->enqidx.load(atomic_order::relaxed) && !s->next.load(atomic_order::acquire);	// NOTE: Approximate
+		}
+
+		/// Segments
+		pf_hint_nodiscard size_t
+		num_segments() const pf_attr_noexcept
+		{
+			return this->numSegments_.load(atomic_order::relaxed);
+		}
+
+	private:
+		/// Pool -> Size
+		pf_hint_nodiscard pf_decl_static size_t
+		__pool_size(
+		 size_t __maxPooled) pf_attr_noexcept
+		{
+			size_t s = 2;
+			while(s < __maxPooled) s <<= 1;	 // NOTE: The pool is a mpmc_ring
+			return s;
+		}
+
+		/// Taken
+		pf_hint_nodiscard pf_decl_static _Ty *
+		__taken() pf_attr_noexcept
+		{
+			pf_decl_static byte_t t = 0;
+			return union_cast<_Ty *>(&t);
+		}
+
+		// Store
+		pf_alignas(CCY_ALIGN) atomic<__segment_t *> head_;
+		pf_alignas(CCY_ALIGN) atomic<__segment_t *> tail_;
+		pf_alignas(CCY_ALIGN) atomic<__segment_t *> retired_;
+		atomic<size_t> numSegments_;
+		mpmc_ring<__segment_t> pool_;
+		const size_t numHazards_;
+		__hazard_t *hazards_;
+	};
+
+	/// QUEUE: MPMC 2 (Multi-CAS)
+	template<typename _Ty>
+	class mpmc_lifo2
+	{
+	private:
+		/// Type -> Header
+		struct __header_t
+		{
+			/// Constructors
+			__header_t() pf_attr_noexcept
+				: head(0)
+				, writer(0)
+				, tail(0)
+			{}
+			__header_t(__header_t const &) = delete;
+			__header_t(__header_t &&)			 = delete;
+
+			/// Destructor
+			~__header_t() pf_attr_noexcept = default;
+
+			/// Operator =
+			__header_t &
+			operator=(__header_t const &) = delete;
+			__header_t &
+			operator=(__header_t &&) = delete;
+
+			/// Store
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> head;
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> writer;
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> tail;
+		};
+
+		// [b ][H1][H2][..][HN][L1][L2][..][LN]
+
+		/// Type -> Buffer
+		struct __buffer_t
+		{
+			/// Constructors
+			__buffer_t(
+			 size_t __seqcount) pf_attr_noexcept
+				: seqcount(__seqcount)
+			{
+				pf_assert(this->seqcount > CCY_NUM_THREADS * 64, "seqcount_ must be greater than {}. seqcount_={}", CCY_NUM_THREADS * 64, this->seqcount);
+
+				// Construct Headers
+				for(uint32_t i = 0; i < CCY_NUM_THREADS; ++i)
+				{
+					construct(this->__get_header(i));
+				}
+			}
+			__buffer_t(__buffer_t const &) = delete;
+			__buffer_t(__buffer_t &&)			 = delete;
+
+			/// Destructor
+			~__buffer_t() pf_attr_noexcept
+			{
+				// Destroy Headers
+				for(uint32_t i = 0; i < CCY_NUM_THREADS; ++i)
+				{
+					destroy(this->__get_header(i));
+				}
+			}
+
+			/// Operator =
+			__buffer_t &
+			operator=(__buffer_t const &) = delete;
+			__buffer_t &
+			operator=(__buffer_t &&) = delete;
+
+			/// Get Header
+			pf_hint_nodiscard pf_decl_inline __header_t *
+			__get_header(
+			 uint32_t __k) pf_attr_noexcept
+			{
+				return union_cast<__header_t *>(
+				 &this->store[0] + __k * sizeof(__header_t));
+			}
+
+			/// Get list
+			pf_hint_nodiscard pf_decl_inline _Ty **
+			__get_list(
+			 uint32_t __k) pf_attr_noexcept
+			{
+				return union_cast<_Ty **>(
+				 &this->store[0] + CCY_NUM_THREADS * sizeof(__header_t) + __k * this->seqcount * sizeof(_Ty *));
+			}
+
+			/// Enqueue
+			size_t
+			__try_enqueue(
+			 _Ty *__ptr) pf_attr_noexcept
+			{
+				const thread_id_t idx = this_thread::get_idx() % CCY_NUM_THREADS;	// NOTE: A starting hint, lists are shared
+				uint32_t i						= idx;
+				do {
+					__header_t *c		 = this->__get_header(i);
+					const uint32_t h = c->head.load(atomic_order::acquire);
+					uint32_t t			 = c->tail.load(atomic_order::acquire);
+					if(t - h >= this->seqcount || !c->tail.compare_exchange_strong(t, t + 1, atomic_order::release, atomic_order::relaxed))
+					{
+						i = (i + 1) % CCY_NUM_THREADS;
+					}
+					else
+					{
+						auto l								= this->__get_list(i);
+						l[t % this->seqcount] = __ptr;
+						while(c->writer.load(atomic_order::acquire) != t) this_thread::yield();	// NOTE: Publishes in ticket order, earlier writers may still be copying
+						c->writer.store(t + 1, atomic_order::release);
+						return 1;
+					}
+				} while(i != idx);
+				return 0;
+			}
+			template<typename _IteratorIn>
+			size_t
+			__try_enqueue_bulk(
+			 _IteratorIn __beg,
+			 _IteratorIn __end) pf_attr_noexcept
+				requires(is_iterator_v<_IteratorIn> && std::is_same_v<value_type_t<_IteratorIn>, _Ty *>)
+			{
+				const uint32_t count = countof(__beg, __end);
+				if(pf_unlikely(count == 0 || count > this->seqcount)) return 0;
+				const thread_id_t idx = this_thread::get_idx() % CCY_NUM_THREADS;
+				uint32_t i						= idx;
+				do {
+					__header_t *c		 = this->__get_header(i);
+					const uint32_t h = c->head.load(atomic_order::acquire);
+					uint32_t t			 = c->tail.load(atomic_order::acquire);
+					if(t - h + count > this->seqcount || !c->tail.compare_exchange_strong(t, t + count, atomic_order::release, atomic_order::relaxed))
+					{
+						i = (i + 1) % CCY_NUM_THREADS;
+					}
+					else
+					{
+						auto l = this->__get_list(i);
+						for(uint32_t k = 0; k < count; ++k)
+						{
+							l[(t + k) % this->seqcount] = __beg[k];
+						}
+						while(c->writer.load(atomic_order::acquire) != t) this_thread::yield();
+						c->writer.store(t + count, atomic_order::release);
+						return count;
+					}
+				} while(i != idx);
+				return 0;
+			}
+
+			/// Dequeue
+			pf_hint_nodiscard _Ty *
+			__try_dequeue() pf_attr_noexcept
+			{
+				const thread_id_t idx = this_thread::get_idx() % CCY_NUM_THREADS;
+				uint32_t i						= idx;
+				do {
+					__header_t *c		 = this->__get_header(i);
+					uint32_t h			 = c->head.load(atomic_order::acquire);
+					const uint32_t t = c->writer.load(atomic_order::acquire);
+					if(h == t || !c->head.compare_exchange_strong(h, h + 1, atomic_order::release, atomic_order::relaxed))
+					{
+						i = (i + 1) % CCY_NUM_THREADS;
+					}
+					else
+					{
+						auto l = this->__get_list(i);
+						return l[h % this->seqcount];
+					}
+				} while(i != idx);
+				return nullptr;
+			}
+			template<typename _IteratorOut>
+			pf_hint_nodiscard size_t
+			__try_dequeue_bulk(
+			 _IteratorOut __beg,
+			 _IteratorOut __end) pf_attr_noexcept
+				requires(is_iterator_v<_IteratorOut> && std::is_same_v<value_type_t<_IteratorOut>, _Ty *>)
+			{
+				const thread_id_t idx = this_thread::get_idx() % CCY_NUM_THREADS;
+				const uint32_t count	= union_cast<uint32_t>(countof(__beg, __end));
+				if(pf_unlikely(count == 0)) return 0;
+				uint32_t i = idx;
+				do {
+					__header_t *c						 = this->__get_header(i);
+					uint32_t h							 = c->head.load(atomic_order::acquire);
+					const uint32_t t				 = c->writer.load(atomic_order::acquire);
+					const uint32_t available = t - h;
+					uint32_t num						 = count > available ? available : count;
+					if(num == 0 || !c->head.compare_exchange_strong(h, h + num, atomic_order::release, atomic_order::relaxed))
+					{
+						i = (i + 1) % CCY_NUM_THREADS;
+					}
+					else
+					{
+						auto l = this->__get_list(i);
+						for(size_t k = 0; k < num; ++k)
+						{
+							__beg[k] = l[(h + k) % this->seqcount];
+						}
+						return num;
+					}
+				} while(i != idx);
+				return 0;
+			}
+
+			/// Empty
+			pf_hint_nodiscard bool
+			__empty() const pf_attr_noexcept
+			{
+				for(size_t i = 0; i < CCY_NUM_THREADS; ++i)
+				{
+					__header_t *c = this->__get_header(i);
+					uint32_t h		= c->head.load(atomic_order::acquire);
+					uint32_t t		= c->tail.load(atomic_order::acquire);
+					if(h != t) return false;
+				}
+				return true;
+			}
+
+			/// Store
+			// Flexible Arrays -> Disable warning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+			const size_t seqcount;
+			pf_alignas(CCY_ALIGN) byte_t store[];
+
+			// Flexible Arrays
+#pragma GCC diagnostic pop
+		};
+
+		/// Buffer -> New
+		pf_hint_nodiscard __buffer_t *
+		__new_buffer(
+		 size_t __seqcount) pf_attr_noexcept
+		{
+			__buffer_t *b = new_construct_ex<__buffer_t>(CCY_NUM_THREADS * (sizeof(__header_t) + __seqcount * sizeof(_Ty *)), __seqcount);
+			std::memset(&b->store[0] + CCY_NUM_THREADS * sizeof(__header_t), 0, __seqcount * sizeof(_Ty *) * CCY_NUM_THREADS);
+			return b;
+		}
+
+		/// Buffer -> Delete
+		void
+		__delete_buffer(
+		 __buffer_t *__buffer) pf_attr_noexcept
+		{
+			destroy_delete(__buffer);
+		}
+
+	public:
+		/// Constructors
+		pf_decl_inline
+		mpmc_lifo2(
+		 size_t __seqcount)
+			: buf_(this->__new_buffer(__seqcount))
+		{}
+		pf_decl_inline
+		mpmc_lifo2(
+		 mpmc_lifo2<_Ty> const &__other)
+			: buf_(this->__new_buffer(__other.buf_->seqcount))
+		{}
+		pf_decl_inline
+		mpmc_lifo2(
+		 mpmc_lifo2<_Ty> &&__other)
+			: buf_(__other.buf_)
+		{
+			__other.buf_ = this->__new_buffer(__other.buf_->seqcount);
+		}
+
+		/// Operator =
+		pf_decl_inline mpmc_lifo2<_Ty> &
+		operator=(
+		 mpmc_lifo2<_Ty> const &__other)
+		{
+			if(pf_likely(this != __other))
+			{
+				pf_assert(this->__empty(), "Deleting not empty buffer!");
+				this->__delete_buffer(this->buf_);
+				this->buf_ = this->__new_buffer(__other.buf_->seqcount);
+			}
+			return *this;
+		}
+		pf_decl_inline mpmc_lifo2<_Ty> &
+		operator=(
+		 mpmc_lifo2<_Ty> &&__other)
+		{
+			if(pf_likely(this != __other))
+			{
+				pf_assert(this->__empty(), "Deleting not empty buffer!");
+				this->__delete_buffer(this->buf_);
+				this->buf_	 = __other.buf_;
+				__other.buf_ = this->__new_buffer(__other.buf_->seqcount);
+			}
+			return *this;
+		}
+
+		/// Destructor
+		pf_decl_inline ~mpmc_lifo2() pf_attr_noexcept
+		{
+			this->__delete_buffer(this->buf_);
+		}
+
+		/// Enqueue
+		pf_decl_inline bool
+		try_enqueue(
+		 _Ty *__ptr) pf_attr_noexcept
+		{
+			return this->buf_->__try_enqueue(__ptr);
+		}
+		template<typename _IteratorIn>
+		pf_decl_inline bool
+		try_enqueue_bulk(
+		 _IteratorIn __beg,
+		 _IteratorIn __end) pf_attr_noexcept
+			requires(is_iterator_v<_IteratorIn> && std::is_same_v<value_type_t<_IteratorIn>, _Ty *>)
+		{
+			return this->buf_->__try_enqueue_bulk(__beg, __end);
+		}
+
+		/// Dequeue
+		pf_hint_nodiscard pf_decl_inline _Ty *
+		try_dequeue() pf_attr_noexcept
+		{
+			return this->buf_->__try_dequeue();
+		}
+		template<typename _IteratorOut>
+		pf_hint_nodiscard pf_decl_inline size_t
+		try_dequeue_bulk(
+		 _IteratorOut __beg,
+		 _IteratorOut __end) pf_attr_noexcept
+			requires(is_iterator_v<_IteratorOut> && std::is_same_v<value_type_t<_IteratorOut>, _Ty *>)
+		{
+			return this->buf_->__try_dequeue_bulk(__beg, __end);
+		}
+
+	private:
+		/// Store
+		__buffer_t *buf_;
+	};
+
+	/// QUEUE: SPMC Deque (Chase-Lev)
+	// https://fzn.fr/readings/ppopp13.pdf
+	template<typename _Ty>
+	class spmc_deque
+	{
+	private:
+		/// Type -> Buffer
+		struct __buffer_t
+		{
+			/// Constructors
+			__buffer_t(
+			 size_t __maxcount) pf_attr_noexcept
+				: top(0)
+				, bottom(0)
+				, mask(__maxcount - 1)
+			{
+				pf_assert(is_power_of_two(__maxcount), "maxcount must be a power of two! maxcount={}", __maxcount);
+				for(size_t i = 0; i < __maxcount; ++i)
+				{
+					construct(&this->elements[i], nullptr);
+				}
+			}
+			__buffer_t(__buffer_t const &) = delete;
+			__buffer_t(__buffer_t &&)			 = delete;
+
+			/// Destructor
+			~__buffer_t() pf_attr_noexcept = default;
+
+			/// Operator =
+			__buffer_t &
+			operator=(__buffer_t const &) = delete;
+			__buffer_t &
+			operator=(__buffer_t &&) = delete;
+
+			/// Push (Owner)
+			bool
+			__try_push(
+			 _Ty *__ptr) pf_attr_noexcept
+			{
+				const diff_t b = this->bottom.load(atomic_order::relaxed);
+				const diff_t t = this->top.load(atomic_order::acquire);
+				if(pf_unlikely(b - t > union_cast<diff_t>(this->mask))) return false;
+				this->elements[b & this->mask].store(__ptr, atomic_order::relaxed);
+				std::atomic_thread_fence(atomic_order::release);
+				this->bottom.store(b + 1, atomic_order::relaxed);
+				return true;
+			}
+
+			/// Pop (Owner)
+			pf_hint_nodiscard _Ty *
+			__try_pop() pf_attr_noexcept
+			{
+				const diff_t b = this->bottom.load(atomic_order::relaxed) - 1;
+				this->bottom.store(b, atomic_order::relaxed);
+				std::atomic_thread_fence(atomic_order::seq_cst);
+				diff_t t = this->top.load(atomic_order::relaxed);
+				if(t > b)
+				{
+					this->bottom.store(b + 1, atomic_order::relaxed);
+					return nullptr;
+				}
+				_Ty *p = this->elements[b & this->mask].load(atomic_order::relaxed);
+				if(t == b)	// Last element, race against thieves
+				{
+					if(!this->top.compare_exchange_strong(t, t + 1, atomic_order::seq_cst, atomic_order::relaxed)) p = nullptr;
+					this->bottom.store(b + 1, atomic_order::relaxed);
+				}
+				return p;
+			}
+
+			/// Steal (Thieves)
+			pf_hint_nodiscard _Ty *
+			__try_steal() pf_attr_noexcept
+			{
+				diff_t t = this->top.load(atomic_order::acquire);
+				std::atomic_thread_fence(atomic_order::seq_cst);
+				const diff_t b = this->bottom.load(atomic_order::acquire);
+				if(t >= b) return nullptr;
+				_Ty *p = this->elements[t & this->mask].load(atomic_order::relaxed);
+				if(!this->top.compare_exchange_strong(t, t + 1, atomic_order::seq_cst, atomic_order::relaxed)) return nullptr;
+				return p;
+			}
+
+			/// Size
+			pf_hint_nodiscard size_t
+			__size() const pf_attr_noexcept
+			{
+				const diff_t b = this->bottom.load(atomic_order::relaxed);
+				const diff_t t = this->top.load(atomic_order::relaxed);
+				return b > t ? union_cast<size_t>(b - t) : 0;
+			}
+
+			/// Store
+			// Flexible Arrays -> Disable warning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+			pf_alignas(CCY_ALIGN) atomic<diff_t> top;
+			pf_alignas(CCY_ALIGN) atomic<diff_t> bottom;
+			const size_t mask;
+			pf_alignas(CCY_ALIGN) atomic<_Ty *> elements[];
+
+			// Flexible Arrays
+#pragma GCC diagnostic pop
+		};
+
+		/// Buffer -> New
+		pf_hint_nodiscard __buffer_t *
+		__new_buffer(
+		 size_t __maxcount)
+		{
+			return new_construct_ex<__buffer_t>(sizeof(atomic<_Ty *>) * __maxcount, __maxcount);
+		}
+
+		/// Buffer -> Delete
+		void
+		__delete_buffer(
+		 __buffer_t *__buffer) pf_attr_noexcept
+		{
+			if(__buffer) destroy_delete(__buffer);
+		}
+
+	public:
+		/// Constructors
+		pf_decl_inline
+		spmc_deque(
+		 size_t __maxcount)
+			: buf_(this->__new_buffer(__maxcount))
+		{}
+		spmc_deque(spmc_deque<_Ty> const &) = delete;
+		pf_decl_inline
+		spmc_deque(
+		 spmc_deque<_Ty> &&__other) pf_attr_noexcept
+			: buf_(__other.buf_)
+		{
+			__other.buf_ = nullptr;
+		}
+
+		/// Destructor
+		pf_decl_inline ~spmc_deque() pf_attr_noexcept
+		{
+			this->__delete_buffer(this->buf_);
+		}
+
+		/// Operator =
+		spmc_deque<_Ty> &
+		operator=(spmc_deque<_Ty> const &) = delete;
+		pf_decl_inline spmc_deque<_Ty> &
+		operator=(
+		 spmc_deque<_Ty> &&__other) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__other))
+			{
+				pf_assert(this->empty(), "Deleting not empty buffer!");
+				this->__delete_buffer(this->buf_);
+				this->buf_	 = __other.buf_;
+				__other.buf_ = nullptr;
+			}
+			return *this;
+		}
+
+		/// Push
+		pf_decl_inline bool
+		try_push(
+		 _Ty *__ptr) pf_attr_noexcept
+		{
+			return this->buf_->__try_push(__ptr);
+		}
+
+		/// Pop
+		pf_hint_nodiscard pf_decl_inline _Ty *
+		try_pop() pf_attr_noexcept
+		{
+			return this->buf_->__try_pop();
+		}
+
+		/// Steal
+		pf_hint_nodiscard pf_decl_inline _Ty *
+		try_steal() pf_attr_noexcept
+		{
+			return this->buf_->__try_steal();
+		}
+
+		/// Size
+		pf_hint_nodiscard pf_decl_inline size_t
+		size() const pf_attr_noexcept
+		{
+			return this->buf_->__size();
+		}
+		pf_hint_nodiscard pf_decl_inline bool
+		empty() const pf_attr_noexcept
+		{
+			return this->size() == 0;
+		}
+
+	private:
+		/// Store
+		__buffer_t *buf_;
+	};
+
+	/// MAP: Concurrent Hash
+	/*! @brief Open-addressed hash map with linear probing. Lookups never lock nor write, writers publish immutable nodes
+	 *				 with a CAS on their slot and replaced nodes are freed once no epoch_guard can reach them. Past 3/4 of claimed
+	 *				 slots a larger table is linked, the writers touching the old one copy it CHUNK_SIZE slots at a time.
+	 */
+	template<
+	 typename _Key,
+	 typename _Ty,
+	 typename _Hash			 = std::hash<_Key>,
+	 typename _Equal		 = std::equal_to<_Key>,
+	 typename _Allocator = allocator_halloc>
+		requires(
+		 std::is_copy_constructible_v<_Key> && std::is_copy_constructible_v<_Ty>
+		 && is_allocator_v<_Allocator>)
+	class concurrent_hash_map
+	{
+	public:
+		pf_decl_static pf_decl_constexpr size_t CHUNK_SIZE				 = 64;	// Slots copied by a writer meeting a resize
+		pf_decl_static pf_decl_constexpr size_t RECLAIM_THRESHOLD = 64;	// Retired nodes between two reclaims
+
+	private:
+		/// Type -> Retired
+		struct __retired_t
+		{
+			__retired_t *next;
+			uint64_t epoch;
+			bool isTable;
+		};
+
+		/// Type -> Node
+		struct __node_t
+		{
+			/// Constructors
+			template<
+			 typename _KeyR,
+			 typename... _Args>
+			__node_t(
+			 size_t __hash,
+			 _KeyR &&__key,
+			 _Args &&...__args)
+				: retired { nullptr, 0, false }
+				, hash(__hash)
+				, key(std::forward<_KeyR>(__key))
+				, value(std::forward<_Args>(__args)...)
+			{}
+
+			/// Store
+			__retired_t retired;	// NOTE: First, nodes and tables share the retire list
+			size_t hash;
+			const _Key key;
+			const _Ty value;
+		};
+
+		/// Type -> Table
+		struct __table_t
+		{
+			/// Constructors
+			__table_t(
+			 size_t __capacity) pf_attr_noexcept
+				: retired { nullptr, 0, true }
+				, next(nullptr)
+				, numClaimed(0)
+				, copyIdx(0)
+				, numCopied(0)
+				, capacity(__capacity)
+			{}
+
+			/// Slots
+			pf_hint_nodiscard atomic<uintptr_t> *
+			__slots() pf_attr_noexcept
+			{
+				return union_cast<atomic<uintptr_t> *>(this + 1);
+			}
+
+			/// Store
+			__retired_t retired;
+			pf_alignas(CCY_ALIGN) atomic<__table_t *> next;
+			pf_alignas(CCY_ALIGN) atomic<size_t> numClaimed;
+			pf_alignas(CCY_ALIGN) atomic<size_t> copyIdx;
+			atomic<size_t> numCopied;
+			const size_t capacity;
+		};
+
+		/// Type -> Counter
+		struct __counter_t
+		{
+			pf_alignas(CCY_ALIGN) atomic<diff_t> value = 0;
+		};
+
+		/// Slot
+		// NOTE: A slot is owned by the first key published in it, an erased key keeps its node flagged until the table is freed
+		pf_decl_static pf_decl_constexpr uintptr_t SLOT_DELETED = 1;
+		pf_decl_static pf_decl_constexpr uintptr_t SLOT_MOVED		= 2;	// Frozen, the newer table holds the key
+		pf_decl_static pf_decl_constexpr uintptr_t SLOT_MASK		= 3;
+		pf_decl_static pf_decl_constexpr size_t NO_SLOT					= ~size_t(0);
+
+		pf_hint_nodiscard pf_decl_static __node_t *
+		__to_node(
+		 uintptr_t __v) pf_attr_noexcept
+		{
+			return union_cast<__node_t *>(__v & ~SLOT_MASK);
+		}
+		pf_hint_nodiscard pf_decl_static bool
+		__is_live(
+		 uintptr_t __v) pf_attr_noexcept
+		{
+			return (__v & ~SLOT_MASK) != 0 && !(__v & SLOT_DELETED);
+		}
+
+		/// Hash
+		pf_hint_nodiscard size_t
+		__hash(
+		 _Key const &__key) const
+		{
+			uint64_t h = static_cast<uint64_t>(this->hash_(__key));
+			h ^= h >> 33;	 // NOTE: Murmur3 finalizer, identity hashes would cluster with linear probing
+			h *= 0xff51afd7ed558ccdull;
+			h ^= h >> 33;
+			h *= 0xc4ceb9fe1a85ec53ull;
+			h ^= h >> 33;
+			return static_cast<size_t>(h);
+		}
+
+		/// Node
+		template<typename... _Args>
+		pf_hint_nodiscard __node_t *
+		__node_new(
+		 size_t __hash,
+		 _Args &&...__args)
+		{
+			__node_t *n = union_cast<__node_t *>(allocate(this->allocator_, sizeof(__node_t), align_val_t(alignof(__node_t))));
+			pf_throw_if(
+			 !n,
+			 dbg_category_generic(),
+			 dbg_code::bad_alloc,
+			 dbg_flags::none,
+			 "Cannot allocate concurrent_hash_map node!");
+			try
+			{
+				construct(n, __hash, std::forward<_Args>(__args)...);
+			} catch(...)
+			{
+				deallocate(this->allocator_, n);
+				throw;
+			}
+			return n;
+		}
+		void
+		__node_delete(
+		 __node_t *__node) pf_attr_noexcept
+		{
+			destroy(__node);
+			deallocate(this->allocator_, __node);
+		}
+
+		/// Table
+		pf_hint_nodiscard __table_t *
+		__table_new(
+		 size_t __capacity)
+		{
+			__table_t *t = union_cast<__table_t *>(allocate(this->allocator_, sizeof(__table_t) + __capacity * sizeof(atomic<uintptr_t>), align_val_t(alignof(__table_t))));
+			pf_throw_if(
+			 !t,
+			 dbg_category_generic(),
+			 dbg_code::bad_alloc,
+			 dbg_flags::none,
+			 "Cannot allocate concurrent_hash_map table! capacity={}",
+			 __capacity);
+			construct(t, __capacity);
+			atomic<uintptr_t> *s = t->__slots();
+			for(size_t i = 0; i != __capacity; ++i) construct(&s[i], uintptr_t(0));
+			return t;
+		}
+		void
+		__table_delete(
+		 __table_t *__table) pf_attr_noexcept
+		{
+			// NOTE: Copies clone their node, a table owns every node in its slots, frozen or not
+			atomic<uintptr_t> *s = __table->__slots();
+			for(size_t i = 0; i != __table->capacity; ++i)
+			{
+				__node_t *n = __to_node(s[i].load(atomic_order::relaxed));
+				if(n) this->__node_delete(n);
+			}
+			destroy(__table);
+			deallocate(this->allocator_, __table);
+		}
+
+		/// Retire
+		void
+		__retire(
+		 __retired_t *__r) pf_attr_noexcept
+		{
+			__r->epoch = __epoch_global().load(atomic_order::seq_cst);	// NOTE: Unlinked already
+			__r->next	 = this->retired_.load(atomic_order::relaxed);
+			while(!this->retired_.compare_exchange_weak(__r->next, __r, atomic_order::release, atomic_order::relaxed))
+				;
+			if((this->numRetired_.fetch_add(1, atomic_order::relaxed) + 1) % RECLAIM_THRESHOLD == 0) this->__reclaim();
+		}
+		void
+		__free(
+		 __retired_t *__r) pf_attr_noexcept
+		{
+			if(__r->isTable)
+				this->__table_delete(union_cast<__table_t *>(__r));
+			else
+				this->__node_delete(union_cast<__node_t *>(__r));
+		}
+		void
+		__reclaim() pf_attr_noexcept
+		{
+			if(this->reclaiming_.exchange(true, atomic_order::acquire)) return;	// NOTE: Another writer is on it
+			try
+			{
+				epoch_reclaim();	// NOTE: Advances the global epoch once every pinned thread caught up
+			} catch(std::exception const &)
+			{}
+			const uint64_t g = __epoch_global().load(atomic_order::acquire);
+			__retired_t *r	 = this->retired_.exchange(nullptr, atomic_order::acquire);
+			size_t f				 = 0;
+			while(r)
+			{
+				__retired_t *x = r->next;
+				if(r->epoch + 2 <= g)
+				{
+					this->__free(r);
+					++f;
+				}
+				else
+				{
+					r->next = this->retired_.load(atomic_order::relaxed);
+					while(!this->retired_.compare_exchange_weak(r->next, r, atomic_order::release, atomic_order::relaxed))
+						;
+				}
+				r = x;
+			}
+			this->numRetired_.fetch_sub(f, atomic_order::relaxed);
+			this->reclaiming_.store(false, atomic_order::release);
+		}
+
+		/// Count
+		void
+		__count(
+		 diff_t __d) pf_attr_noexcept
+		{
+			this->counters_[this_thread::get_idx() % this->numCounters_].value.fetch_add(__d, atomic_order::relaxed);	// NOTE: Striped, writers don't share a line
+		}
+
+		/// Probe
+		/*! @brief Index of the slot owned by __key, or of the empty slot ending its chain. NO_SLOT when the table is full.
+		 */
+		pf_hint_nodiscard size_t
+		__probe(
+		 __table_t *__t,
+		 size_t __hash,
+		 _Key const &__key,
+		 uintptr_t &__v) const
+		{
+			atomic<uintptr_t> *s = __t->__slots();
+			const size_t m			 = __t->capacity - 1;
+			size_t k						 = __hash & m;
+			for(size_t i = 0; i != __t->capacity; ++i, k = (k + 1) & m)
+			{
+				const uintptr_t v = s[k].load(atomic_order::acquire);
+				__node_t *n				= __to_node(v);
+				if(!n || (n->hash == __hash && this->equal_(n->key, __key)))
+				{
+					__v = v;
+					return k;
+				}
+			}
+			return NO_SLOT;
+		}
+
+		/// Resize
+		pf_hint_nodiscard __table_t *
+		__resize(
+		 __table_t *__t)
+		{
+			__table_t *n = __t->next.load(atomic_order::acquire);
+			if(n) return n;
+
+			// Capacity -> Doubled, unless erased keys take most of the claimed slots
+			diff_t l = 0;
+			for(size_t i = 0; i != this->numCounters_; ++i) l += this->counters_[i].value.load(atomic_order::relaxed);
+			size_t c = __t->capacity;
+			if(l >= diff_t(c / 4)) c <<= 1;
+
+			// Link
+			__table_t *g = this->__table_new(c);
+			if(__t->next.compare_exchange_strong(n, g, atomic_order::acq_rel, atomic_order::acquire))
+			{
+				this->__help_copy(__t);
+				return g;
+			}
+			this->__table_delete(g);	// NOTE: Never published
+			return n;
+		}
+		void
+		__help_copy(
+		 __table_t *__t)
+		{
+			const size_t i = __t->copyIdx.fetch_add(CHUNK_SIZE, atomic_order::relaxed);
+			if(i >= __t->capacity) return;
+			const size_t e = i + CHUNK_SIZE < __t->capacity ? i + CHUNK_SIZE : __t->capacity;
+			for(size_t k = i; k != e; ++k) this->__copy_slot(__t, k);
+		}
+		void
+		__copy_slot(
+		 __table_t *__t,
+		 size_t __k)
+		{
+			// Freeze -> Only its freezer copies a slot and counts it
+			// NOTE: The clone is made before freezing, a throwing copy constructor leaves the slot unfrozen for another helper
+			atomic<uintptr_t> &s = __t->__slots()[__k];
+			uintptr_t v					 = s.load(atomic_order::acquire);
+			uintptr_t w					 = 0;
+			__node_t *c					 = nullptr;
+			while(!(v & SLOT_MOVED))
+			{
+				if(__is_live(v) && v != w)
+				{
+					if(c) this->__node_delete(c);
+					c						= nullptr;
+					__node_t *o = __to_node(v);
+					c						= this->__node_new(o->hash, o->key, o->value);
+					w						= v;
+				}
+				if(s.compare_exchange_weak(v, v | SLOT_MOVED, atomic_order::acq_rel, atomic_order::acquire))
+				{
+					// NOTE: Past the freeze only a newer table may fail to allocate, the slot then stays uncounted and __locate copies its key
+					if(__is_live(v))
+						this->__put_copy(__t->next.load(atomic_order::acquire), __to_node(v), c);
+					else if(c)
+						this->__node_delete(c);
+					this->__copied(__t);
+					return;
+				}
+			}
+			if(c) this->__node_delete(c);	 // NOTE: Frozen by another helper
+		}
+		void
+		__put_copy(
+		 __table_t *__t,
+		 __node_t *__node,
+		 __node_t *__clone)
+		{
+			__node_t *c = __clone;
+			try
+			{
+				while(true)
+				{
+					uintptr_t v		 = 0;
+					const size_t k = this->__probe(__t, __node->hash, __node->key, v);
+					if(k == NO_SLOT)
+					{
+						__t = this->__resize(__t);
+						continue;
+					}
+
+					// Owned -> The copy landed already, or a newer write superseded it
+					if(__to_node(v)) break;
+
+					// Empty -> Claimed here, or in the newer table once frozen
+					atomic<uintptr_t> &s = __t->__slots()[k];
+					__table_t *n				 = __t->next.load(atomic_order::acquire);
+					if(v & SLOT_MOVED)
+					{
+						__t = n;
+						continue;
+					}
+					if(n)
+					{
+						this->__copy_slot(__t, k);
+						continue;
+					}
+					if(!c) c = this->__node_new(__node->hash, __node->key, __node->value);
+					if(s.compare_exchange_strong(v, union_cast<uintptr_t>(c), atomic_order::acq_rel, atomic_order::acquire))
+					{
+						this->__claimed(__t);
+						return;
+					}
+				}
+			} catch(...)
+			{
+				if(c) this->__node_delete(c);	 // NOTE: Never published
+				throw;
+			}
+			if(c) this->__node_delete(c);	 // NOTE: Never published
+		}
+		void
+		__copied(
+		 __table_t *__t) pf_attr_noexcept
+		{
+			if(__t->numCopied.fetch_add(1, atomic_order::acq_rel) + 1 == __t->capacity) this->__promote();
+		}
+		void
+		__promote() pf_attr_noexcept
+		{
+			__table_t *t = this->current_.load(atomic_order::acquire);
+			while(t->numCopied.load(atomic_order::acquire) == t->capacity)
+			{
+				__table_t *n = t->next.load(atomic_order::acquire);
+				if(this->current_.compare_exchange_strong(t, n, atomic_order::acq_rel, atomic_order::acquire))
+				{
+					this->__retire(&t->retired);
+					t = n;
+				}
+			}
+		}
+		void
+		__claimed(
+		 __table_t *__t) pf_attr_noexcept
+		{
+			if(__t->numClaimed.fetch_add(1, atomic_order::relaxed) + 1 <= __t->capacity / 4 * 3) return;
+			try
+			{
+				ignore = this->__resize(__t);
+			} catch(...)
+			{
+				// NOTE: Early growth only, the slot is published already and a full probe resizes again
+			}
+		}
+
+		/// Locate
+		/*! @brief Slot owned by __key, or the empty one ending its chain, in the newest table. Older tables met on the way
+		 *				 have the key's slot frozen and copied first, so no newer value can live elsewhere.
+		 */
+		pf_hint_nodiscard atomic<uintptr_t> *
+		__locate(
+		 size_t __hash,
+		 _Key const &__key,
+		 __table_t *&__t,
+		 uintptr_t &__v)
+		{
+			__table_t *t = this->current_.load(atomic_order::acquire);
+			while(true)
+			{
+				__table_t *n = t->next.load(atomic_order::acquire);
+				if(n) this->__help_copy(t);
+				uintptr_t v		 = 0;
+				const size_t k = this->__probe(t, __hash, __key, v);
+				if(k == NO_SLOT)
+				{
+					t = this->__resize(t);
+					continue;
+				}
+				atomic<uintptr_t> *s = &t->__slots()[k];
+				if(!(v & SLOT_MOVED) && n)
+				{
+					this->__copy_slot(t, k);
+					v = s->load(atomic_order::acquire);
+				}
+				if(v & SLOT_MOVED)
+				{
+					if(__is_live(v)) this->__put_copy(t->next.load(atomic_order::acquire), __to_node(v), nullptr);	// NOTE: Its freezer may still be copying it
+					t = t->next.load(atomic_order::acquire);
+					continue;
+				}
+				__t = t;
+				__v = v;
+				return s;
+			}
+		}
+
+		/// Find
+		pf_hint_nodiscard __node_t *
+		__find(
+		 _Key const &__key) const
+		{
+			// NOTE: Writes into a newer table freeze the key's slot first, an unfrozen slot is the latest state.
+			//			 A frozen one is, until its copy lands.
+			const size_t h = this->__hash(__key);
+			uintptr_t f		 = 0;
+			__table_t *t	 = this->current_.load(atomic_order::acquire);
+			while(t)
+			{
+				uintptr_t v		 = 0;
+				const size_t k = this->__probe(t, h, __key, v);
+				if(__to_node(v)) f = v;
+				if(k != NO_SLOT && !(v & SLOT_MOVED)) break;
+				t = t->next.load(atomic_order::acquire);
+			}
+			return __is_live(f) ? __to_node(f) : nullptr;
+		}
+
+		/// Size
+		pf_hint_nodiscard pf_decl_static size_t
+		__table_size(
+		 size_t __capacity) pf_attr_noexcept
+		{
+			size_t s = 8;
+			while(s < __capacity * 2) s <<= 1;	// NOTE: Power of two, half full at most before the first resize
+			return s;
+		}
+
+	public:
+		/// Constructors
+		concurrent_hash_map(
+		 size_t __capacity			 = 64,
+		 _Hash &&__hash					 = _Hash(),
+		 _Equal &&__equal				 = _Equal(),
+		 _Allocator &&__allocator = _Allocator())
+			: current_(nullptr)
+			, retired_(nullptr)
+			, numRetired_(0)
+			, reclaiming_(false)
+			, numCounters_(CCY_NUM_THREADS)
+			, counters_(new_construct<__counter_t[]>(CCY_NUM_THREADS))
+			, hash_(std::move(__hash))
+			, equal_(std::move(__equal))
+			, allocator_(std::move(__allocator))
+		{
+			this->current_.store(this->__table_new(__table_size(__capacity)), atomic_order::relaxed);
+		}
+		concurrent_hash_map(concurrent_hash_map const &) = delete;
+		concurrent_hash_map(concurrent_hash_map &&)			 = delete;
+
+		/// Destructor
+		~concurrent_hash_map() pf_attr_noexcept
+		{
+			__retired_t *r = this->retired_.load(atomic_order::acquire);
+			while(r)
+			{
+				__retired_t *x = r->next;
+				this->__free(r);
+				r = x;
+			}
+			__table_t *t = this->current_.load(atomic_order::acquire);
+			while(t)
+			{
+				__table_t *n = t->next.load(atomic_order::relaxed);
+				this->__table_delete(t);
+				t = n;
+			}
+			destroy_delete<__counter_t[]>(this->counters_);
+		}
+
+		/// Operator =
+		concurrent_hash_map &
+		operator=(concurrent_hash_map const &) = delete;
+		concurrent_hash_map &
+		operator=(concurrent_hash_map &&) = delete;
+
+		/// Find
+		/*! @brief Copies the value of __key in __out, lock-free.
+		 */
+		pf_hint_nodiscard bool
+		find(
+		 _Key const &__key,
+		 _Ty &__out) const
+		{
+			epoch_guard g;
+			__node_t *n = this->__find(__key);
+			if(!n) return false;
+			__out = n->value;
+			return true;
+		}
+		/*! @brief Calls __fun with the value of __key without copying it, the reference dies with the call.
+		 */
+		template<typename _FunTy>
+		bool
+		visit(
+		 _Key const &__key,
+		 _FunTy &&__fun) const
+			requires(std::is_invocable_v<_FunTy, _Ty const &>)
+		{
+			epoch_guard g;
+			__node_t *n = this->__find(__key);
+			if(!n) return false;
+			__fun(n->value);
+			return true;
+		}
+		pf_hint_nodiscard bool
+		contains(
+		 _Key const &__key) const
+		{
+			epoch_guard g;
+			return this->__find(__key) != nullptr;
+		}
+
+		/// Insert
+		/*! @brief Inserts __key with a value built from __args, unless present.
+		 */
+		template<typename... _Args>
+		bool
+		insert(
+		 _Key const &__key,
+		 _Args &&...__args)
+			requires(std::is_constructible_v<_Ty, _Args...>)
+		{
+			epoch_guard g;
+			const size_t h = this->__hash(__key);
+			__node_t *n		 = nullptr;
+			while(true)
+			{
+				__table_t *t;
+				uintptr_t v;
+				atomic<uintptr_t> *s = this->__locate(h, __key, t, v);
+				if(__is_live(v))
+				{
+					if(n) this->__node_delete(n);	 // NOTE: Never published
+					return false;
+				}
+				if(!n) n = this->__node_new(h, __key, std::forward<_Args>(__args)...);
+				if(s->compare_exchange_strong(v, union_cast<uintptr_t>(n), atomic_order::acq_rel, atomic_order::acquire))
+				{
+					this->__count(1);
+					if(__to_node(v))
+						this->__retire(&__to_node(v)->retired);
+					else
+						this->__claimed(t);
+					return true;
+				}
+			}
+		}
+		/*! @brief Inserts __key or replaces its value, returns true when it was inserted.
+		 */
+		template<typename... _Args>
+		bool
+		insert_or_assign(
+		 _Key const &__key,
+		 _Args &&...__args)
+			requires(std::is_constructible_v<_Ty, _Args...>)
+		{
+			epoch_guard g;
+			const size_t h = this->__hash(__key);
+			__node_t *n		 = this->__node_new(h, __key, std::forward<_Args>(__args)...);
+			while(true)
+			{
+				__table_t *t;
+				uintptr_t v;
+				atomic<uintptr_t> *s = this->__locate(h, __key, t, v);
+				if(s->compare_exchange_strong(v, union_cast<uintptr_t>(n), atomic_order::acq_rel, atomic_order::acquire))
+				{
+					const bool i = !__is_live(v);
+					if(i) this->__count(1);
+					if(__to_node(v))
+						this->__retire(&__to_node(v)->retired);
+					else
+						this->__claimed(t);
+					return i;
+				}
+			}
+		}
+
+		/// Erase
+		bool
+		erase(
+		 _Key const &__key)
+		{
+			epoch_guard g;
+			const size_t h = this->__hash(__key);
+			while(true)
+			{
+				__table_t *t;
+				uintptr_t v;
+				atomic<uintptr_t> *s = this->__locate(h, __key, t, v);
+				if(!__is_live(v)) return false;
+				if(s->compare_exchange_strong(v, v | SLOT_DELETED, atomic_order::acq_rel, atomic_order::acquire))
+				{
+					this->__count(-1);
+					return true;
+				}
+			}
+		}
+
+		/// Size
+		pf_hint_nodiscard size_t
+		size() const pf_attr_noexcept
+		{
+			diff_t l = 0;
+			for(size_t i = 0; i != this->numCounters_; ++i) l += this->counters_[i].value.load(atomic_order::relaxed);
+			return l > 0 ? static_cast<size_t>(l) : 0;	// NOTE: Approximate while written
+		}
+		pf_hint_nodiscard bool
+		empty() const pf_attr_noexcept
+		{
+			return this->size() == 0;
+		}
+		pf_hint_nodiscard size_t
+		capacity() const
+		{
+			epoch_guard g;
+			return this->current_.load(atomic_order::acquire)->capacity;
+		}
+
+	private:
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<__table_t *> current_;
+		pf_alignas(CCY_ALIGN) atomic<__retired_t *> retired_;
+		atomic<size_t> numRetired_;
+		atomic<bool> reclaiming_;
+		const size_t numCounters_;
+		__counter_t *counters_;
+		pf_hint_nounique_address _Hash hash_;
+		pf_hint_nounique_address _Equal equal_;
+		pf_hint_nounique_address _Allocator allocator_;
 	};
 
 	/// SINGLY: MPSC List
@@ -1222,7 +3073,7 @@ namespace pul
 			 _NodeTy *__e) pf_attr_noexcept
 			{
 				// Initialization
-				uint32_t i = this_thread::get_idx();
+				uint32_t i = this_thread::get_idx() % CCY_NUM_THREADS;
 				auto *l		 = this->__get_list(i);
 				_NodeTy *t = l->tail.load(atomic_order::relaxed);
 
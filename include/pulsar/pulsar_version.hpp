@@ -15,9 +15,9 @@
 #define PULSAR_VERSION_MAJOR         0
 #define PULSAR_VERSION_MINOR         1
 #define PULSAR_VERSION_PATCH         6
-#define PULSAR_VERSION_SHA_1        "0932fc3"
-#define PULSAR_VERSION_BRANCH       "dev"
-#define PULSAR_VERSION_STRING       "0.1.6-dev-0932fc3"
+#define PULSAR_VERSION_SHA_1        ""
+#define PULSAR_VERSION_BRANCH       ""
+#define PULSAR_VERSION_STRING       "0.1.6--"
 #define PULSAR_VERSION_STRING_SHORT "0.1.6"
 
 #endif // !PULSAR_VERSION_HPP
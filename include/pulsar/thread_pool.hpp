@@ -21,9 +21,19 @@
 #include "pulsar/intrin.hpp"
 #include "pulsar/iterable.hpp"
 
+// Include: C++
+#include <coroutine>
+
 // Pulsar
 namespace pul
 {
+	/// CONCURRENCY: Task -> Priority
+	enum class task_priority : uint32_t
+	{
+		critical	 = 0,
+		normal		 = 1,
+		background = 2
+	};
 
 	/// CONCURRENCY: Task -> Process
 	pulsar_api bool
@@ -31,6 +41,474 @@ namespace pul
 	pulsar_api uint32_t
 	process_tasks_0();
 
+	/*! @brief Runs main thread tasks one by one until the budget is spent or the queue is empty.
+	 *				 A task is only started before the deadline, the ones left stay queued in order.
+	 *				 Returns how many main thread tasks are still queued, 0 once drained.
+	 */
+	pulsar_api uint32_t
+	process_tasks_0_for(
+	 nanoseconds_t __budget);
+	pulsar_api uint32_t
+	process_tasks_0_until(
+	 high_resolution_point_t __deadline);
+
+	/// CONCURRENCY: Task -> Spin Budget
+	/*! @brief Number of yields an idle worker spins before parking on the pool's eventcount.
+	 */
+	pf_hint_nodiscard pulsar_api uint32_t
+	thread_pool_spin_budget() pf_attr_noexcept;
+	pulsar_api void
+	thread_pool_set_spin_budget(
+	 uint32_t __budget) pf_attr_noexcept;
+
+	/// CONCURRENCY: Topology
+	struct cpu_info_t
+	{
+		uint32_t id;			 // Logical CPU
+		uint32_t core;		 // Dense physical core index, shared by SMT siblings
+		uint32_t package;	 // Socket
+		uint32_t cache;		 // Dense L3 domain index
+	};
+
+	/*! @brief Topology of the CPUs this process is allowed to run on.
+	 *				 Discovered once from /sys/devices/system/cpu and sched_getaffinity on Linux,
+	 *				 elsewhere every hardware thread is reported as its own core in a single domain.
+	 */
+	pf_hint_nodiscard pulsar_api uint32_t
+	cpu_topology_num_cpus() pf_attr_noexcept;
+	pf_hint_nodiscard pulsar_api uint32_t
+	cpu_topology_num_cores() pf_attr_noexcept;
+	pf_hint_nodiscard pulsar_api uint32_t
+	cpu_topology_num_caches() pf_attr_noexcept;
+	pf_hint_nodiscard pulsar_api uint32_t
+	cpu_topology_quota() pf_attr_noexcept;	// NOTE: cgroup CPU quota rounded up, 0 when unlimited
+	pf_hint_nodiscard pulsar_api cpu_info_t
+	cpu_topology_get(
+	 uint32_t __index) pf_attr_noexcept;
+
+	/// CONCURRENCY: Thread Pool -> Workers
+	/*! @brief Number of workers of the global pool. It starts at CCY_NUM_WORKERS and may be changed
+	 *				 with thread_pool_resize: new workers start, then the old ones finish what was submitted to them.
+	 *				 Throws if the threads would outnumber CCY_MAX_THREADS, or when called from inside a submission.
+	 */
+	pf_hint_nodiscard pulsar_api uint32_t
+	thread_pool_num_workers() pf_attr_noexcept;
+	pulsar_api void
+	thread_pool_resize(
+	 uint32_t __numWorkers);
+
+	/// CONCURRENCY: Thread Pool -> Overflow
+	/*! @brief What a submission does when the lane it targets is full.
+	 *				 Continuations, coroutine resumptions, graph nodes and timers always block, they can't be dropped.
+	 */
+	enum class task_overflow : uint32_t
+	{
+		block			 = 0,	 // The submitter helps the pool, or yields, until there is room
+		run_inline = 1,	 // The submitter runs the task itself, main thread tasks included
+		fail			 = 2	 // The task is destroyed without running, submit_task returns false
+	};
+	pf_hint_nodiscard pulsar_api task_overflow
+	thread_pool_overflow() pf_attr_noexcept;
+	pulsar_api void
+	thread_pool_set_overflow(
+	 task_overflow __policy) pf_attr_noexcept;
+
+	/// CONCURRENCY: Thread Pool -> Capacity
+	/*! @brief Number of tasks each lane of the global pool holds, spread over one list per thread.
+	 *				 Lists are rounded up to a power of two above CCY_NUM_THREADS * 64 slots, 0 restores the default.
+	 *				 Changing it restarts the pool like thread_pool_resize.
+	 */
+	pf_hint_nodiscard pulsar_api size_t
+	thread_pool_capacity() pf_attr_noexcept;
+	pulsar_api void
+	thread_pool_set_capacity(
+	 size_t __capacity);
+
+	/*! @brief Tasks submitted to the workers and not finished yet, main thread tasks aside.
+	 *				 Producers may compare it against thread_pool_capacity to throttle before hitting the overflow policy.
+	 */
+	pf_hint_nodiscard pulsar_api uint32_t
+	thread_pool_num_pending() pf_attr_noexcept;
+
+	/// CONCURRENCY: Thread Pool -> Stats
+	struct thread_pool_stats_t
+	{
+		uint64_t numExecuted;			 // Tasks run by the worker, helping included
+		uint64_t numExceptions;		 // Exceptions caught and moved to the main thread record
+		uint64_t numLocal;				 // Tasks popped from the worker's own deque
+		uint64_t numShared;				 // Tasks dequeued from a shared lane
+		uint64_t numStolen;				 // Tasks stolen from another worker's deque
+		uint64_t numMisses;				 // Dequeue attempts that found every lane and victim empty
+		uint64_t busyTime;				 // Nanoseconds spent processing
+		uint64_t idleTime;				 // Nanoseconds spent spinning or parked
+		uint64_t depthSum;				 // Sum of the pending task counts sampled when a worker starts a batch
+		uint64_t numDepthSamples;
+		uint32_t depthMax;
+	};
+
+	/*! @brief Snapshot of the global pool's counters, summed over its workers or for a single one.
+	 *				 Each worker writes its own counters with plain relaxed stores, reading them costs the workers nothing.
+	 *				 Counters start again from zero when the pool is resized. A worker __index out of range throws.
+	 */
+	pf_hint_nodiscard pulsar_api thread_pool_stats_t
+	thread_pool_stats() pf_attr_noexcept;
+	pf_hint_nodiscard pulsar_api thread_pool_stats_t
+	thread_pool_worker_stats(
+	 uint32_t __index);
+
+	/// CONCURRENCY: Thread Pool -> Affinity
+	enum class thread_affinity : uint32_t
+	{
+		none					= 0,	// Workers may run on any allowed CPU
+		physical_core = 1,	// One worker per physical core, SMT siblings are left free
+		cache_domain	= 2		// Workers are packed on L3 domains, each one may float within its domain
+	};
+	pf_hint_nodiscard pulsar_api thread_affinity
+	thread_pool_affinity() pf_attr_noexcept;
+	pulsar_api bool
+	thread_pool_set_affinity(
+	 thread_affinity __affinity) pf_attr_noexcept;
+
+	/// CONCURRENCY: Type -> Task Function
+	using __task_fun_t = fun_ptr<void(void *)>;
+
+	/// CONCURRENCY: Task -> Flags
+	pf_decl_constexpr uint32_t CCY_TASK_FLAG_NONE				= 0x00;
+	pf_decl_constexpr uint32_t CCY_TASK_FLAG_PERSISTENT = 0x01;	 // Owned by its submitter, never deleted by the pool
+	pf_decl_constexpr uint32_t CCY_TASK_FLAG_0					= 0x02;	 // Continuations are enqueued on the main thread queue
+	pf_decl_constexpr uint32_t CCY_TASK_FLAG_SLAB				= 0x04;	 // Allocated in a per-thread task slab
+	pf_decl_constexpr uint32_t CCY_TASK_FLAG_INLINE			= 0x08;	 // Continuation run by the completing thread, must be short and noexcept
+
+	/// CONCURRENCY: Task -> Slab
+	/*! @brief Tasks and future stores up to this size (and aligned up to CCY_ALIGN) are carved from
+	 *				 per-thread slabs of fixed size-class bins (64, 128, 256, 512 bytes) instead of the cache allocator.
+	 */
+	pf_decl_constexpr size_t CCY_TASK_SLAB_MAX_SIZE = 512;
+
+	pf_hint_nodiscard pf_decl_inline pf_decl_constexpr bool
+	__task_slab_fits(
+	 size_t __size,
+	 size_t __align) pf_attr_noexcept
+	{
+		return __size <= CCY_TASK_SLAB_MAX_SIZE && __align <= static_cast<size_t>(CCY_ALIGN);
+	}
+	pf_hint_nodiscard pulsar_api void *
+	__task_slab_allocate(
+	 size_t __size,
+	 size_t __align);
+	pulsar_api void
+	__task_slab_deallocate(
+	 void *__ptr) pf_attr_noexcept;
+
+	/*! @brief Number of allocations the task system made since startup: slab chunks plus the tasks
+	 *				 that were too large for a bin and fell back to the cache allocator.
+	 */
+	pf_hint_nodiscard pulsar_api size_t
+	thread_pool_num_allocations() pf_attr_noexcept;
+
+	template<typename _Ty>
+	pf_decl_inline void
+	__task_slab_free(
+	 _Ty *__ptr) pf_attr_noexcept
+	{
+		if pf_decl_constexpr(__task_slab_fits(sizeof(_Ty), alignof(_Ty)))
+			__task_slab_deallocate(__ptr);
+		else
+			cfree(__ptr);
+	}
+
+	/// CONCURRENCY: Type -> Task
+	struct __task_t pf_attr_final
+	{
+		/// Constructors
+		__task_t(
+		 __task_fun_t __fun,
+		 uint32_t __flags = CCY_TASK_FLAG_NONE) pf_attr_noexcept
+			: task_(__fun)
+			, flags_(__flags)
+		{}
+		__task_t(__task_t const &) = delete;
+		__task_t(__task_t &&)			 = delete;
+
+		/// Destructor
+		~__task_t() pf_attr_noexcept = default;
+
+		/// Operator =
+		__task_t &
+		operator=(__task_t const &) = delete;
+		__task_t &
+		operator=(__task_t &&) = delete;
+
+		/// Call
+		pf_decl_inline void
+		__call()
+		{
+			this->task_(this + 1);
+		}
+
+		/// Run
+		pf_decl_inline void
+		__run()
+		{
+			if(this->flags_ & CCY_TASK_FLAG_PERSISTENT)
+			{
+				this->__call();	 // NOTE: Its owner may free it during the call, it mustn't be touched afterwards
+				return;
+			}
+			try
+			{
+				this->__call();
+			} catch(std::exception const &)
+			{
+				this->__delete();
+				throw;
+			}
+			this->__delete();
+		}
+
+		/// Delete
+		pf_decl_inline void
+		__delete() pf_attr_noexcept
+		{
+			if(this->flags_ & CCY_TASK_FLAG_SLAB)
+			{
+				destroy(this);
+				__task_slab_deallocate(this);
+			}
+			else
+			{
+				destroy_delete_c(this);
+			}
+		}
+
+		/// Store
+		__task_fun_t task_;
+		uint32_t flags_;
+	};
+
+	/// CONCURRENCY: Task -> Enqueue
+	pulsar_api void
+	__task_enqueue_0(
+	 __task_t *__task) pf_attr_noexcept;
+	pulsar_api void
+	__task_enqueue(
+	 __task_t *__task) pf_attr_noexcept;
+	pulsar_api void
+	__task_enqueue(
+	 task_priority __priority,
+	 __task_t *__task) pf_attr_noexcept;
+
+	/// CONCURRENCY: Task -> Submit
+	/*! @brief Enqueues __task following __policy once its lane is full. Returns false when the task was refused,
+	 *				 the caller then still owns it. Bulk submissions return how many tasks were taken, in order.
+	 */
+	pulsar_api bool
+	__task_submit_0(
+	 __task_t *__task,
+	 task_overflow __policy);
+	pulsar_api bool
+	__task_submit(
+	 __task_t *__task,
+	 task_overflow __policy);
+	pulsar_api bool
+	__task_submit(
+	 task_priority __priority,
+	 __task_t *__task,
+	 task_overflow __policy);
+	pulsar_api size_t
+	__task_submit_bulk(
+	 __task_t **__beg,
+	 __task_t **__end,
+	 task_overflow __policy);
+
+	/// CONCURRENCY: Task -> Help
+	pf_decl_constexpr uint32_t CCY_HELP_MAX_DEPTH = 16;
+
+	/*! @brief Runs one pending task of the pool the calling thread works for, or of the global pool.
+	 *				 The main thread runs its own queue first, a throw is kept and raised by the next process_tasks_0.
+	 *				 Returns false when nothing ran, or when this thread is already helping CCY_HELP_MAX_DEPTH levels deep.
+	 */
+	pulsar_api bool
+	__task_help() pf_attr_noexcept;
+
+	/*! @brief Waits until __done() holds. The main thread processes its own queue meanwhile,
+	 *				 other threads execute pending tasks so that nested waits can't starve the pool.
+	 */
+	template<typename _PredTy>
+	pf_decl_inline void
+	__task_wait_until(
+	 _PredTy &&__done) pf_attr_noexcept
+	{
+		while(!__done())
+		{
+			if(!__task_help()) this_thread::yield();
+		}
+	}
+
+	/// CONCURRENCY: Task -> Bulk
+	pf_decl_constexpr size_t CCY_TASKS_BULK_NUM = 256;	// NOTE: Tasks built on the stack before each bulk enqueue
+
+	pf_decl_inline void
+	__task_enqueue_continuation(
+	 __task_t *__task) pf_attr_noexcept
+	{
+		if(__task->flags_ & CCY_TASK_FLAG_INLINE)
+			__task->__call();
+		else if(__task->flags_ & CCY_TASK_FLAG_0)
+			__task_enqueue_0(__task);
+		else
+			__task_enqueue(__task);
+	}
+
+	/// CONCURRENCY: Task -> Cancel
+	struct __cancel_state_t
+	{
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> numRefs;
+		atomic<bool> cancelled;
+	};
+	class cancel_source;
+
+	/*! @brief Read side of a cancel_source, cheap to copy. A default token is never cancelled.
+	 *				 Tasks capture a copy and poll it at their own pace, cancellation is cooperative.
+	 */
+	class cancel_token pf_attr_final
+	{
+		friend class cancel_source;
+
+		/// Constructors
+		cancel_token(
+		 __cancel_state_t *__state) pf_attr_noexcept
+			: state_(__state)
+		{
+			if(this->state_) this->state_->numRefs.fetch_add(1, atomic_order::relaxed);
+		}
+
+	public:
+		/// Constructors
+		cancel_token() pf_attr_noexcept
+			: state_(nullptr)
+		{}
+		cancel_token(
+		 cancel_token const &__r) pf_attr_noexcept
+			: cancel_token(__r.state_)
+		{}
+		cancel_token(
+		 cancel_token &&__r) pf_attr_noexcept
+			: state_(__r.state_)
+		{
+			__r.state_ = nullptr;
+		}
+
+		/// Destructor
+		~cancel_token() pf_attr_noexcept
+		{
+			this->__release();
+		}
+
+		/// Operator =
+		cancel_token &
+		operator=(
+		 cancel_token const &__r) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__r))
+			{
+				if(__r.state_) __r.state_->numRefs.fetch_add(1, atomic_order::relaxed);
+				this->__release();
+				this->state_ = __r.state_;
+			}
+			return *this;
+		}
+		cancel_token &
+		operator=(
+		 cancel_token &&__r) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__r))
+			{
+				this->__release();
+				this->state_ = __r.state_;
+				__r.state_	 = nullptr;
+			}
+			return *this;
+		}
+
+		/// Cancelled?
+		pf_hint_nodiscard pf_decl_inline bool
+		is_cancelled() const pf_attr_noexcept
+		{
+			return this->state_ && this->state_->cancelled.load(atomic_order::acquire);
+		}
+
+	private:
+		/// Release
+		void
+		__release() pf_attr_noexcept
+		{
+			if(this->state_ && this->state_->numRefs.fetch_sub(1, atomic_order::acq_rel) == 1)
+			{
+				destroy(this->state_);
+				__task_slab_free(this->state_);
+			}
+			this->state_ = nullptr;
+		}
+
+		/// Store
+		__cancel_state_t *state_;
+	};
+
+	/*! @brief Owner side of a cancellation. Every copy shares the same state, cancel() is sticky.
+	 */
+	class cancel_source pf_attr_final
+	{
+	public:
+		/// Constructors
+		cancel_source()
+			: token_(new(__task_slab_allocate(sizeof(__cancel_state_t), alignof(__cancel_state_t))) __cancel_state_t { 0, false })
+		{}
+		cancel_source(cancel_source const &)		 = default;
+		cancel_source(cancel_source &&) pf_attr_noexcept = default;
+
+		/// Destructor
+		~cancel_source() pf_attr_noexcept = default;
+
+		/// Operator =
+		cancel_source &
+		operator=(cancel_source const &) = default;
+		cancel_source &
+		operator=(cancel_source &&) pf_attr_noexcept = default;
+
+		/// Cancel
+		void
+		cancel() pf_attr_noexcept
+		{
+			if(this->token_.state_) this->token_.state_->cancelled.store(true, atomic_order::release);
+		}
+
+		/// Cancelled?
+		pf_hint_nodiscard pf_decl_inline bool
+		is_cancelled() const pf_attr_noexcept
+		{
+			return this->token_.is_cancelled();
+		}
+
+		/// Token
+		pf_hint_nodiscard pf_decl_inline cancel_token
+		token() const pf_attr_noexcept
+		{
+			return this->token_;
+		}
+
+	private:
+		/// Store
+		cancel_token token_;
+	};
+
+	/// CONCURRENCY: Task -> Future -> Sealed
+	pf_hint_nodiscard pf_decl_inline __task_t *
+	__future_sealed() pf_attr_noexcept
+	{
+		return union_cast<__task_t *>(size_t(1));	 // NOTE: Marks a finished store, no continuation can be attached anymore
+	}
+
 	/// CONCURRENCY: Task -> Future
 	template<typename _RetTy>
 	struct __future_store pf_attr_final
@@ -38,6 +516,8 @@ namespace pul
 		/// Constructors
 		__future_store() pf_attr_noexcept
 			: finished(false)
+			, cancelled(false)
+			, next(nullptr)
 			, retVal { 0 }
 		{}
 		__future_store(__future_store<_RetTy> const &) = delete;
@@ -56,37 +536,34 @@ namespace pul
 		pf_hint_nodiscard bool
 		__is_finished() pf_attr_noexcept
 		{
-			return this->finished.load(atomic_order::relaxed);
+			return this->finished.load(atomic_order::acquire);
 		}
 
 		/// Wait
 		bool
 		__wait() pf_attr_noexcept
 		{
-			bool b = this->finished.load(atomic_order::relaxed);
+			bool b = this->finished.load(atomic_order::acquire);
 			if(b) return false;
-			if(this_thread::get_idx() == 0)
-			{
-				while(!this->finished.load(atomic_order::relaxed))
-				{
-					process_tasks_0();
-				}
-			}
-			else
-			{
-				while(!this->finished.load(atomic_order::relaxed))
-				{
-					this_thread::yield();
-				}
-			}
+			__task_wait_until(
+			 [this]()
+			 { return this->finished.load(atomic_order::acquire); });
 			return !b;
 		}
 
+		/// Is Cancelled?
+		pf_hint_nodiscard bool
+		__is_cancelled() pf_attr_noexcept
+		{
+			return this->finished.load(atomic_order::acquire) && this->cancelled;
+		}
+
 		/// Check For Exception
 		void
 		__check_exception()
 		{
 			this->__wait();
+			__check_cancelled();
 			record.rethrow();
 		}
 
@@ -95,12 +572,47 @@ namespace pul
 		__value()
 		{
 			this->__wait();
+			__check_cancelled();
 			record.rethrow();
 			return std::move(*union_cast<_RetTy *>(&this->retVal[0]));
 		}
 
+		/// Continuation
+		void
+		__finish() pf_attr_noexcept
+		{
+			__task_t *t = this->next.exchange(__future_sealed(), atomic_order::acq_rel);
+			this->finished.store(true, atomic_order::release);	// NOTE: Before the continuation, which may check it
+			if(t) __task_enqueue_continuation(t);	 // NOTE: The store may be freed already, t only owns it for then()
+		}
+		void
+		__then(
+		 __task_t *__task) pf_attr_noexcept
+		{
+			__task_t *t = nullptr;
+			if(!this->next.compare_exchange_strong(t, __task, atomic_order::acq_rel, atomic_order::acquire))
+			{
+				__task_enqueue_continuation(__task);
+			}
+		}
+
+		/// Cancel
+		void
+		__cancel() pf_attr_noexcept
+		{
+			this->cancelled = true;
+			this->__finish();
+		}
+		void
+		__check_cancelled() const
+		{
+			if(this->cancelled) pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Task was cancelled before it started.");
+		}
+
 		/// Store
 		pf_alignas(64) atomic<bool> finished;
+		bool cancelled;	 // NOTE: Written before finished
+		atomic<__task_t *> next;
 		__dbg_exception_record_t record;
 		byte_t retVal[sizeof(_RetTy)];
 	};
@@ -109,6 +621,8 @@ namespace pul
 	{
 		__future_store() pf_attr_noexcept
 			: finished(false)
+			, cancelled(false)
+			, next(nullptr)
 		{}
 		__future_store(__future_store<void> const &) = delete;
 		__future_store(__future_store<void> &&)			 = delete;
@@ -126,53 +640,105 @@ namespace pul
 		pf_hint_nodiscard bool
 		__is_finished() pf_attr_noexcept
 		{
-			return this->finished.load(atomic_order::relaxed);
+			return this->finished.load(atomic_order::acquire);
 		}
 
 		/// Wait
 		bool
 		__wait()
 		{
-			bool b = this->finished.load(atomic_order::relaxed);
+			bool b = this->finished.load(atomic_order::acquire);
 			if(b) return false;
-			if(this_thread::get_idx() == 0)
-			{
-				while(!this->finished.load(atomic_order::relaxed))
-				{
-					process_tasks_0();
-				}
-			}
-			else
-			{
-				while(!this->finished.load(atomic_order::relaxed))
-				{
-					this_thread::yield();
-				}
-			}
+			__task_wait_until(
+			 [this]()
+			 { return this->finished.load(atomic_order::acquire); });
 			return !b;
 		}
 
+		/// Is Cancelled?
+		pf_hint_nodiscard bool
+		__is_cancelled() pf_attr_noexcept
+		{
+			return this->finished.load(atomic_order::acquire) && this->cancelled;
+		}
+
 		/// Check For Exception
 		void
 		__check_exception()
 		{
 			this->__wait();
+			__check_cancelled();
 			record.rethrow();
 		}
 
-		/// Store
-		pf_alignas(64) atomic<bool> finished;
-		__dbg_exception_record_t record;
-	};
-	template<typename _RetTy>
-	class future pf_attr_final
-	{
-	public:
-		/// Constructors
-		future(
-		 __future_store<_RetTy> *__store) pf_attr_noexcept
-			: store_(__store)
-		{}
+		/// Continuation
+		void
+		__finish() pf_attr_noexcept
+		{
+			__task_t *t = this->next.exchange(__future_sealed(), atomic_order::acq_rel);
+			this->finished.store(true, atomic_order::release);	// NOTE: Before the continuation, which may check it
+			if(t) __task_enqueue_continuation(t);	 // NOTE: The store may be freed already, t only owns it for then()
+		}
+		void
+		__then(
+		 __task_t *__task) pf_attr_noexcept
+		{
+			__task_t *t = nullptr;
+			if(!this->next.compare_exchange_strong(t, __task, atomic_order::acq_rel, atomic_order::acquire))
+			{
+				__task_enqueue_continuation(__task);
+			}
+		}
+
+		/// Cancel
+		void
+		__cancel() pf_attr_noexcept
+		{
+			this->cancelled = true;
+			this->__finish();
+		}
+		void
+		__check_cancelled() const
+		{
+			if(this->cancelled) pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Task was cancelled before it started.");
+		}
+
+		/// Store
+		pf_alignas(64) atomic<bool> finished;
+		bool cancelled;	 // NOTE: Written before finished
+		atomic<__task_t *> next;
+		__dbg_exception_record_t record;
+	};
+
+	/// CONCURRENCY: Task -> Future -> Allocation
+	template<typename _RetTy>
+	pf_hint_nodiscard pf_decl_inline __future_store<_RetTy> *
+	__future_store_new()
+	{
+		return new(__task_slab_allocate(sizeof(__future_store<_RetTy>), alignof(__future_store<_RetTy>))) __future_store<_RetTy>();
+	}
+	template<typename _RetTy>
+	pf_decl_inline void
+	__future_store_delete(
+	 __future_store<_RetTy> *__store) pf_attr_noexcept
+	{
+		destroy(__store);
+		__task_slab_free(__store);
+	}
+
+	template<typename _RetTy>
+	struct __future_awaiter;
+	template<typename _RetTy>
+	struct __future_promise;
+	template<typename _RetTy>
+	class future pf_attr_final
+	{
+	public:
+		/// Constructors
+		future(
+		 __future_store<_RetTy> *__store) pf_attr_noexcept
+			: store_(__store)
+		{}
 		future(future<_RetTy> const &) = delete;
 		future(future<_RetTy> &&__r)
 			: store_(__r.store_)
@@ -186,7 +752,7 @@ namespace pul
 			if(this->store_)
 			{
 				this->wait();
-				destroy_delete(this->store_);
+				__future_store_delete(this->store_);
 			}
 		}
 
@@ -203,6 +769,16 @@ namespace pul
 			return this->store_->__is_finished();
 		}
 
+		/// Is Cancelled?
+		/*! @brief True once finished without running because its cancel_token was cancelled.
+		 *				 Such a future throws from value() and check_exception().
+		 */
+		pf_hint_nodiscard pf_decl_inline bool
+		is_cancelled() const pf_attr_noexcept
+		{
+			return this->store_->__is_cancelled();
+		}
+
 		/// Wait
 		pf_decl_inline bool
 		wait() const pf_attr_noexcept
@@ -224,6 +800,29 @@ namespace pul
 			return this->store_->__value();
 		}
 
+		/// Then
+		/*! @brief Consumes this future, @a __fun is submitted to the pool with the value once it is ready.
+		 */
+		template<typename _FunTy>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _RetTy>>
+		then(
+		 _FunTy &&__fun) &&
+			requires(std::is_invocable_v<_FunTy, _RetTy>);
+
+		/// Coroutine
+		using promise_type = __future_promise<_RetTy>;
+		pf_hint_nodiscard __future_awaiter<_RetTy>
+		operator co_await() const pf_attr_noexcept;
+		pf_hint_nodiscard __future_awaiter<_RetTy>
+		await_0() const pf_attr_noexcept;
+
+		/// Store
+		pf_hint_nodiscard pf_decl_inline __future_store<_RetTy> *
+		__store() const pf_attr_noexcept
+		{
+			return this->store_;
+		}
+
 	private:
 		__future_store<_RetTy> *store_;
 	};
@@ -249,7 +848,7 @@ namespace pul
 			if(this->store_)
 			{
 				this->wait();
-				destroy_delete(this->store_);
+				__future_store_delete(this->store_);
 			}
 		}
 
@@ -266,6 +865,16 @@ namespace pul
 			return this->store_->__is_finished();
 		}
 
+		/// Is Cancelled?
+		/*! @brief True once finished without running because its cancel_token was cancelled.
+		 *				 Such a future throws from value() and check_exception().
+		 */
+		pf_hint_nodiscard pf_decl_inline bool
+		is_cancelled() const pf_attr_noexcept
+		{
+			return this->store_->__is_cancelled();
+		}
+
 		/// Wait
 		pf_decl_inline bool
 		wait() const pf_attr_noexcept
@@ -280,43 +889,31 @@ namespace pul
 			return this->store_->__check_exception();
 		}
 
-	private:
-		__future_store<void> *store_;
-	};
-
-	/// CONCURRENCY: Type -> Task Function
-	using __task_fun_t = fun_ptr<void(void *)>;
-
-	/// CONCURRENCY: Type -> Task
-	struct __task_t pf_attr_final
-	{
-		/// Constructors
-		__task_t(
-		 __task_fun_t __fun) pf_attr_noexcept
-			: task_(__fun)
-		{}
-		__task_t(__task_t const &) = delete;
-		__task_t(__task_t &&)			 = delete;
-
-		/// Destructor
-		~__task_t() pf_attr_noexcept = default;
+		/// Then
+		template<typename _FunTy>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy>>
+		then(
+		 _FunTy &&__fun) &&
+			requires(std::is_invocable_v<_FunTy>);
 
-		/// Operator =
-		__task_t &
-		operator=(__task_t const &) = delete;
-		__task_t &
-		operator=(__task_t &&) = delete;
+		/// Coroutine
+		using promise_type = __future_promise<void>;
+		pf_hint_nodiscard __future_awaiter<void>
+		operator co_await() const pf_attr_noexcept;
+		pf_hint_nodiscard __future_awaiter<void>
+		await_0() const pf_attr_noexcept;
 
-		/// Call
-		pf_decl_inline void
-		__call()
+		/// Store
+		pf_hint_nodiscard pf_decl_inline __future_store<void> *
+		__store() const pf_attr_noexcept
 		{
-			this->task_(&this->task_ + 1);
+			return this->store_;
 		}
 
-		/// Store
-		__task_fun_t task_;
+	private:
+		__future_store<void> *store_;
 	};
+
 	template<
 	 typename _FunTy,
 	 typename... _Args>
@@ -439,21 +1036,22 @@ namespace pul
 		{
 			if(this_thread::get_idx() == 0)
 			{
-				data->store->finished.store(true, atomic_order::relaxed);
+				data->store->record.set_record(std::current_exception(), nullptr);	// NOTE: Kept in the store, then() continuations read it
+				data->store->__finish();
 				destroy(data);
-				throw;
+				return;
 			}
 			else
 			{
 				pf_alignas(CCY_ALIGN) atomic<bool> ctrl = false;
 				data->store->record.set_record(std::current_exception(), &ctrl);
-				data->store->finished.store(true, atomic_order::relaxed);
+				data->store->__finish();
 				while(!ctrl.load(atomic_order::relaxed)) this_thread::yield();
 				destroy(data);
 				return;
 			}
 		}
-		data->store->finished.store(true, atomic_order::relaxed);
+		data->store->__finish();
 		destroy(data);
 	}
 	template<
@@ -472,21 +1070,22 @@ namespace pul
 		{
 			if(this_thread::get_idx() == 0)
 			{
-				data->store->finished.store(true, atomic_order::relaxed);
+				data->store->record.set_record(std::current_exception(), nullptr);	// NOTE: Kept in the store, then() continuations read it
+				data->store->__finish();
 				destroy(data);
-				throw;
+				return;
 			}
 			else
 			{
 				pf_alignas(CCY_ALIGN) atomic<bool> ctrl = false;
 				data->store->record.set_record(std::current_exception(), &ctrl);
-				data->store->finished.store(true, atomic_order::relaxed);
+				data->store->__finish();
 				while(!ctrl.load(atomic_order::relaxed)) this_thread::yield();
 				destroy(data);
 				return;
 			}
 		}
-		data->store->finished.store(true, atomic_order::relaxed);
+		data->store->__finish();
 		destroy(data);
 	}
 	template<
@@ -519,471 +1118,3179 @@ namespace pul
 		__task_data_f<_FunTy, _Args...> data;
 	};
 
-	/// CONCURRENCY: Task -> Enqueue
-	pulsar_api void
-	__task_enqueue_0(
-	 __task_t *__task) pf_attr_noexcept;
-	pulsar_api void
-	__task_enqueue(
-	 __task_t *__task) pf_attr_noexcept;
-
-	/// CONCURRENCY: Task -> Submit
 	template<
 	 typename _FunTy,
 	 typename... _Args>
-	pf_decl_static void
-	submit_task(
-	 _FunTy &&__fun,
-	 _Args &&...__args)
-		requires(std::is_invocable_v<_FunTy, _Args...>)
+	struct __task_data_fc pf_attr_final
 	{
-		auto *t = new_construct_c<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
-		__task_enqueue(&t->task);
-	}
+		/// Constructors
+		__task_data_fc(
+		 cancel_token const &__token,
+		 __future_store<std::invoke_result_t<_FunTy, _Args...>> *__store,
+		 _FunTy &&__fun,
+		 _Args &&...__args)
+			: token(__token)
+			, data(__store, std::move(__fun), std::forward<_Args>(__args)...)
+		{}
+		__task_data_fc(__task_data_fc<_FunTy, _Args...> const &) = delete;
+		__task_data_fc(__task_data_fc<_FunTy, _Args...> &&)			 = delete;
+
+		/// Destructor
+		~__task_data_fc() pf_attr_noexcept = default;
+
+		/// Operator =
+		__task_data_fc<_FunTy, _Args...> &
+		operator=(__task_data_fc<_FunTy, _Args...> const &) = delete;
+		__task_data_fc<_FunTy, _Args...> &
+		operator=(__task_data_fc<_FunTy, _Args...> &&) = delete;
+
+		/// Store
+		cancel_token token;
+		__task_data_f<_FunTy, _Args...> data;
+	};
 	template<
 	 typename _FunTy,
 	 typename... _Args>
-	pf_decl_static void
-	submit_task_0(
-	 _FunTy &&__fun,
-	 _Args &&...__args)
-		requires(std::is_invocable_v<_FunTy, _Args...>)
+	pf_decl_inline void
+	__task_data_fc_proc(
+	 void *__data)
 	{
-		auto *t = new_construct_c<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
-		__task_enqueue_0(&t->task);
+		auto data = union_cast<__task_data_fc<_FunTy, _Args...> *>(__data);
+
+		// Cancelled -> Dropped without calling __fun
+		if(data->token.is_cancelled())
+		{
+			auto *s = data->data.store;
+			destroy(data);
+			s->__cancel();
+			return;
+		}
+
+		// Run
+		try
+		{
+			__task_data_f_proc<_FunTy, _Args...>(&data->data);
+		} catch(std::exception const &)
+		{
+			destroy(&data->token);
+			throw;
+		}
+		destroy(&data->token);
 	}
 	template<
 	 typename _FunTy,
 	 typename... _Args>
-	pf_hint_nodiscard pf_decl_static future<std::invoke_result_t<_FunTy, _Args...>>
-	submit_future_task(
-	 _FunTy &&__fun,
+	struct __task_store_fc
+	{
+		/// Constructors
+		__task_store_fc(
+		 cancel_token const &__token,
+		 __future_store<std::invoke_result_t<_FunTy, _Args...>> *__s,
+		 _FunTy &&__fun,
+		 _Args &&...__args)
+			: task(__task_data_fc_proc<_FunTy, _Args...>)
+			, data(__token, __s, std::move(__fun), std::forward<_Args>(__args)...)
+		{}
+		__task_store_fc(__task_store_fc<_FunTy, _Args...> const &) = delete;
+		__task_store_fc(__task_store_fc<_FunTy, _Args...> &&)			 = delete;
+
+		/// Destructor
+		~__task_store_fc() pf_attr_noexcept = default;
+
+		/// Operator =
+		__task_store_fc<_FunTy, _Args...> &
+		operator=(__task_store_fc<_FunTy, _Args...> const &) = delete;
+		__task_store_fc<_FunTy, _Args...> &
+		operator=(__task_store_fc<_FunTy, _Args...> &&) = delete;
+
+		/// Store
+		__task_t task;
+		__task_data_fc<_FunTy, _Args...> data;
+	};
+
+	/// CONCURRENCY: Task -> Allocation
+	template<
+	 typename _TaskStore,
+	 typename... _Args>
+	pf_hint_nodiscard pf_decl_inline _TaskStore *
+	__task_new(
 	 _Args &&...__args)
-		requires(std::is_invocable_v<_FunTy, _Args...>)
 	{
-		auto *s = new_construct<__future_store<std::invoke_result_t<_FunTy, _Args...>>>();
+		void *p = __task_slab_allocate(sizeof(_TaskStore), alignof(_TaskStore));
+		_TaskStore *t;
 		try
 		{
-			auto *t = new_construct_c<__task_store_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
-			__task_enqueue(&t->task);
-			return s;
+			t = new(p) _TaskStore(std::forward<_Args>(__args)...);
 		} catch(std::exception const &)
 		{
-			destroy_delete(s);
+			__task_slab_free(union_cast<_TaskStore *>(p));
 			throw;
 		}
+		if pf_decl_constexpr(__task_slab_fits(sizeof(_TaskStore), alignof(_TaskStore)))
+			t->task.flags_ |= CCY_TASK_FLAG_SLAB;
+		return t;
 	}
-	template<
-	 typename _FunTy,
-	 typename... _Args>
-	pf_hint_nodiscard pf_decl_static future<std::invoke_result_t<_FunTy, _Args...>>
-	submit_future_task_0(
-	 _FunTy &&__fun,
-	 _Args &&...__args)
-		requires(std::is_invocable_v<_FunTy, _Args...>)
+	template<typename _TaskStore>
+	pf_decl_inline void
+	__task_discard(
+	 _TaskStore *__task) pf_attr_noexcept
+	{
+		destroy(__task);	// NOTE: Never ran, its data is destroyed here instead of by its function
+		__task_slab_free(__task);
+	}
+	using __task_discard_fun_t = void (*)(__task_t *);
+	template<typename _TaskStore>
+	pf_decl_static void
+	__task_discard_as(
+	 __task_t *__task) pf_attr_noexcept
+	{
+		__task_discard(union_cast<_TaskStore *>(__task));	 // NOTE: The task is the first member of its store
+	}
+
+	/// CONCURRENCY: Task -> Future -> Then
+	template<typename _RetTy>
+	struct __future_store_guard pf_attr_final
+	{
+		/// Destructor
+		~__future_store_guard() pf_attr_noexcept
+		{
+			__future_store_delete(this->store);
+		}
+
+		/// Store
+		__future_store<_RetTy> *store;
+	};
+	template<typename _RetTy>
+	template<typename _FunTy>
+	future<std::invoke_result_t<_FunTy, _RetTy>>
+	future<_RetTy>::then(
+	 _FunTy &&__fun) &&
+		requires(std::is_invocable_v<_FunTy, _RetTy>)
 	{
-		auto *s = new_construct<__future_store<std::invoke_result_t<_FunTy, _Args...>>>();
+		using __result_t = std::invoke_result_t<_FunTy, _RetTy>;
+		auto *p					 = this->store_;
+		auto c					 = [p, f = std::forward<_FunTy>(__fun)]() mutable -> __result_t
+		{
+			__future_store_guard<_RetTy> g { p };
+			return f(p->__value());
+		};
+		auto *s = __future_store_new<__result_t>();
 		try
 		{
-			auto *t = new_construct_c<__task_store_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
-			__task_enqueue_0(&t->task);
+			auto *t			 = __task_new<__task_store_f<decltype(c)>>(s, std::move(c));
+			this->store_ = nullptr;
+			p->__then(&t->task);
 			return s;
 		} catch(std::exception const &)
 		{
-			destroy_delete(s);
+			__future_store_delete(s);
 			throw;
 		}
 	}
-
-	/// CONCURRENCY: Task -> Pool
-	struct __task_pool_store_t
+	template<typename _FunTy>
+	future<std::invoke_result_t<_FunTy>>
+	future<void>::then(
+	 _FunTy &&__fun) &&
+		requires(std::is_invocable_v<_FunTy>)
 	{
-		/// Type -> Node
-		struct __node_t
+		using __result_t = std::invoke_result_t<_FunTy>;
+		auto *p					 = this->store_;
+		auto c					 = [p, f = std::forward<_FunTy>(__fun)]() mutable -> __result_t
 		{
-			__node_t *next;
-			__task_t task;
+			__future_store_guard<void> g { p };
+			p->__check_exception();
+			return f();
 		};
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		struct __node_data
+		auto *s = __future_store_new<__result_t>();
+		try
 		{
-			/// Constructors
-			__node_data(
-			 _FunTy &&__fun,
-			 _Args &&...__args)
-				: next(nullptr)
-				, data(std::move(__fun), std::forward<_Args>(__args)...)
-			{}
-			__node_data(
-			 __node_data<_FunTy, _Args...> const &) = delete;
-			__node_data(
-			 __node_data<_FunTy, _Args...> &&) = delete;
+			auto *t			 = __task_new<__task_store_f<decltype(c)>>(s, std::move(c));
+			this->store_ = nullptr;
+			p->__then(&t->task);
+			return s;
+		} catch(std::exception const &)
+		{
+			__future_store_delete(s);
+			throw;
+		}
+	}
 
-			/// Destructor
-			~__node_data() pf_attr_noexcept = default;
+	/// CONCURRENCY: Task -> Future -> When
+	struct __when_state_t;
+	struct __when_link_t
+	{
+		__when_state_t *state;
+		uint32_t index;
+	};
+	struct __when_arrival_t
+	{
+		__task_t task;	// NOTE: Persistent and inline, it only counts down
+		__when_link_t link;
+	};
+	struct __when_state_t
+	{
+		/// Constructors
+		__when_state_t(
+		 uint32_t __num,
+		 __future_store<void> *__all,
+		 __future_store<size_t> *__any) pf_attr_noexcept
+			: numPending(__num)
+			, first(~uint32_t(0))
+			, all(__all)
+			, any(__any)
+		{
+			for(uint32_t i = 0; i != __num; ++i)
+			{
+				__when_arrival_t *a = this->__get_arrival(i);
+				construct(&a->task, __proc, CCY_TASK_FLAG_PERSISTENT | CCY_TASK_FLAG_INLINE);
+				a->link = { this, i };
+			}
+		}
+		__when_state_t(__when_state_t const &) = delete;
+		__when_state_t(__when_state_t &&)			 = delete;
 
-			/// Operator =
-			__node_data<_FunTy, _Args...> &
-			operator=(__node_data<_FunTy, _Args...> const &) = delete;
-			__node_data<_FunTy, _Args...> &
-			operator=(__node_data<_FunTy, _Args...> &&) = delete;
+		/// Destructor
+		~__when_state_t() pf_attr_noexcept = default;
 
-			/// Store
-			__node_t *next;
-			__task_store<_FunTy, _Args...> data;
-		};
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		struct __node_data_f
+		/// Operator =
+		__when_state_t &
+		operator=(__when_state_t const &) = delete;
+		__when_state_t &
+		operator=(__when_state_t &&) = delete;
+
+		/// Arrival
+		pf_hint_nodiscard pf_decl_inline __when_arrival_t *
+		__get_arrival(
+		 uint32_t __index) pf_attr_noexcept
 		{
-			/// Constructors
-			__node_data_f(
-			 __future_store<std::invoke_result_t<_FunTy, _Args...>> *__s,
-			 _FunTy &&__fun,
-			 _Args &&...__args)
-				: next(nullptr)
-				, data(__s, std::move(__fun), std::forward<_Args>(__args)...)
-			{}
-			__node_data_f(
-			 __node_data_f<_FunTy, _Args...> const &) = delete;
-			__node_data_f(
+			return union_cast<__when_arrival_t *>(&this->store[0]) + __index;
+		}
+		pf_decl_static void
+		__proc(
+		 void *__data) pf_attr_noexcept
+		{
+			__when_link_t *l = union_cast<__when_link_t *>(__data);
+			__when_state_t *s = l->state;
+
+			// Any -> First arrival completes
+			if(s->any)
+			{
+				uint32_t e = ~uint32_t(0);
+				if(s->first.compare_exchange_strong(e, l->index, atomic_order::acq_rel, atomic_order::relaxed))
+				{
+					construct(union_cast<size_t *>(&s->any->retVal[0]), size_t(l->index));
+					s->any->__finish();
+				}
+			}
+
+			// Countdown -> Last arrival completes all and frees the state
+			if(s->numPending.fetch_sub(1, atomic_order::acq_rel) == 1)
+			{
+				if(s->all)
+				{
+					s->all->__finish();
+				}
+				destroy_delete(s);
+			}
+		}
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> numPending;
+		atomic<uint32_t> first;
+		__future_store<void> *all;
+		__future_store<size_t> *any;
+		pf_alignas(CCY_ALIGN) byte_t store[];	// [a1][a2][an]
+	};
+
+	pf_hint_nodiscard pf_decl_inline __when_state_t *
+	__when_new(
+	 uint32_t __num,
+	 __future_store<void> *__all,
+	 __future_store<size_t> *__any)
+	{
+		return new_construct_ex<__when_state_t>(__num * sizeof(__when_arrival_t), __num, __all, __any);
+	}
+	template<typename _RetTy>
+	pf_decl_inline void
+	__when_attach(
+	 __when_state_t *__state,
+	 uint32_t __index,
+	 future<_RetTy> const &__future) pf_attr_noexcept
+	{
+		__future.__store()->__then(&__state->__get_arrival(__index)->task);	// NOTE: The last attach may free the state
+	}
+
+	/*! @brief Future finished once every input is, through a single atomic countdown.
+	 *				 Inputs must stay alive until then and mustn't have another continuation or awaiter.
+	 *				 They keep their values and exceptions, which are read from them afterwards.
+	 */
+	template<typename _IteratorIn>
+	pf_hint_nodiscard future<void>
+	when_all(
+	 _IteratorIn __beg,
+	 _IteratorIn __end)
+		requires(is_iterator_v<_IteratorIn>)
+	{
+		auto *r						 = __future_store_new<void>();
+		const uint32_t n = static_cast<uint32_t>(countof(__beg, __end));
+		if(n == 0)
+		{
+			r->__finish();
+			return r;
+		}
+		__when_state_t *s;
+		try
+		{
+			s = __when_new(n, r, nullptr);
+		} catch(std::exception const &)
+		{
+			__future_store_delete(r);
+			throw;
+		}
+		for(uint32_t i = 0; __beg != __end; ++__beg, ++i) __when_attach(s, i, *__beg);
+		return r;
+	}
+	template<typename... _RetTys>
+	pf_hint_nodiscard future<void>
+	when_all(
+	 future<_RetTys> &...__futures)
+		requires(sizeof...(_RetTys) > 0)
+	{
+		auto *r = __future_store_new<void>();
+		__when_state_t *s;
+		try
+		{
+			s = __when_new(sizeof...(_RetTys), r, nullptr);
+		} catch(std::exception const &)
+		{
+			__future_store_delete(r);
+			throw;
+		}
+		uint32_t i = 0;
+		(__when_attach(s, i++, __futures), ...);
+		return r;
+	}
+
+	/*! @brief Future holding the index of the first input to finish, the others are only counted down.
+	 *				 The same lifetime rules as when_all apply to every input, not only the first one. Throws on an empty range.
+	 */
+	template<typename _IteratorIn>
+	pf_hint_nodiscard future<size_t>
+	when_any(
+	 _IteratorIn __beg,
+	 _IteratorIn __end)
+		requires(is_iterator_v<_IteratorIn>)
+	{
+		const uint32_t n = static_cast<uint32_t>(countof(__beg, __end));
+		pf_throw_if(
+		 n == 0,
+		 dbg_category_generic(),
+		 dbg_code::invalid_argument,
+		 dbg_flags::none,
+		 "when_any needs at least one future!");
+		auto *r = __future_store_new<size_t>();
+		__when_state_t *s;
+		try
+		{
+			s = __when_new(n, nullptr, r);
+		} catch(std::exception const &)
+		{
+			__future_store_delete(r);
+			throw;
+		}
+		for(uint32_t i = 0; __beg != __end; ++__beg, ++i) __when_attach(s, i, *__beg);
+		return r;
+	}
+	template<typename... _RetTys>
+	pf_hint_nodiscard future<size_t>
+	when_any(
+	 future<_RetTys> &...__futures)
+		requires(sizeof...(_RetTys) > 0)
+	{
+		auto *r = __future_store_new<size_t>();
+		__when_state_t *s;
+		try
+		{
+			s = __when_new(sizeof...(_RetTys), nullptr, r);
+		} catch(std::exception const &)
+		{
+			__future_store_delete(r);
+			throw;
+		}
+		uint32_t i = 0;
+		(__when_attach(s, i++, __futures), ...);
+		return r;
+	}
+
+	/// CONCURRENCY: Coroutine -> Resume
+	struct __co_resume_t pf_attr_final
+	{
+		/// Constructors
+		__co_resume_t(
+		 uint32_t __flags) pf_attr_noexcept
+			: task(__proc, CCY_TASK_FLAG_PERSISTENT | __flags)
+			, handle(nullptr)
+		{}
+		__co_resume_t(__co_resume_t const &) = delete;
+		__co_resume_t(__co_resume_t &&)			 = delete;
+
+		/// Destructor
+		~__co_resume_t() pf_attr_noexcept = default;
+
+		/// Operator =
+		__co_resume_t &
+		operator=(__co_resume_t const &) = delete;
+		__co_resume_t &
+		operator=(__co_resume_t &&) = delete;
+
+		/// Proc
+		pf_decl_static void
+		__proc(
+		 void *__data)
+		{
+			union_cast<std::coroutine_handle<> *>(__data)->resume();
+		}
+
+		/// Store
+		__task_t task;	// NOTE: Lives in the suspended frame, no allocation per resume
+		std::coroutine_handle<> handle;
+	};
+
+	/// CONCURRENCY: Coroutine -> Schedule
+	struct __co_schedule_awaiter pf_attr_final
+	{
+		/// Constructors
+		__co_schedule_awaiter(
+		 uint32_t __flags) pf_attr_noexcept
+			: resume(__flags)
+		{}
+
+		/// Awaiter
+		pf_hint_nodiscard pf_decl_constexpr bool
+		await_ready() const pf_attr_noexcept
+		{
+			return false;
+		}
+		void
+		await_suspend(
+		 std::coroutine_handle<> __h) pf_attr_noexcept
+		{
+			this->resume.handle = __h;
+			__task_enqueue_continuation(&this->resume.task);
+		}
+		pf_decl_constexpr void
+		await_resume() const pf_attr_noexcept
+		{}
+
+		/// Store
+		__co_resume_t resume;
+	};
+	/*! @brief Suspends the calling coroutine and resumes it on a pool worker.
+	 */
+	pf_hint_nodiscard pf_decl_inline __co_schedule_awaiter
+	co_schedule() pf_attr_noexcept
+	{
+		return __co_schedule_awaiter(CCY_TASK_FLAG_NONE);
+	}
+	/*! @brief Suspends the calling coroutine and resumes it on the main thread, through process_tasks_0.
+	 */
+	pf_hint_nodiscard pf_decl_inline __co_schedule_awaiter
+	co_schedule_0() pf_attr_noexcept
+	{
+		return __co_schedule_awaiter(CCY_TASK_FLAG_0);
+	}
+
+	/// CONCURRENCY: Coroutine -> Future Awaiter
+	template<typename _RetTy>
+	struct __future_awaiter pf_attr_final
+	{
+		/// Constructors
+		__future_awaiter(
+		 __future_store<_RetTy> *__store,
+		 uint32_t __flags) pf_attr_noexcept
+			: store(__store)
+			, resume(__flags)
+		{}
+
+		/// Awaiter
+		pf_hint_nodiscard bool
+		await_ready() const pf_attr_noexcept
+		{
+			return this->store->__is_finished();
+		}
+		void
+		await_suspend(
+		 std::coroutine_handle<> __h) pf_attr_noexcept
+		{
+			this->resume.handle = __h;
+			this->store->__then(&this->resume.task);	// NOTE: May resume before returning, this mustn't be touched afterwards
+		}
+		pf_hint_nodiscard _RetTy
+		await_resume()
+		{
+			if constexpr(std::is_void_v<_RetTy>)
+				this->store->__check_exception();
+			else
+				return this->store->__value();
+		}
+
+		/// Store
+		__future_store<_RetTy> *store;
+		__co_resume_t resume;
+	};
+	template<typename _RetTy>
+	__future_awaiter<_RetTy>
+	future<_RetTy>::operator co_await() const pf_attr_noexcept
+	{
+		return __future_awaiter<_RetTy>(this->store_, CCY_TASK_FLAG_NONE);
+	}
+	template<typename _RetTy>
+	__future_awaiter<_RetTy>
+	future<_RetTy>::await_0() const pf_attr_noexcept
+	{
+		return __future_awaiter<_RetTy>(this->store_, CCY_TASK_FLAG_0);
+	}
+	pf_decl_inline __future_awaiter<void>
+	future<void>::operator co_await() const pf_attr_noexcept
+	{
+		return __future_awaiter<void>(this->store_, CCY_TASK_FLAG_NONE);
+	}
+	pf_decl_inline __future_awaiter<void>
+	future<void>::await_0() const pf_attr_noexcept
+	{
+		return __future_awaiter<void>(this->store_, CCY_TASK_FLAG_0);
+	}
+
+	/// CONCURRENCY: Coroutine -> Promise
+	template<typename _RetTy>
+	struct __future_promise_final pf_attr_final
+	{
+		/// Awaiter
+		pf_hint_nodiscard pf_decl_constexpr bool
+		await_ready() const pf_attr_noexcept
+		{
+			return false;
+		}
+		template<typename _Promise>
+		void
+		await_suspend(
+		 std::coroutine_handle<_Promise> __h) pf_attr_noexcept
+		{
+			// NOTE: The frame is gone before anyone can observe the completion
+			__future_store<_RetTy> *s = __h.promise().store;
+			__h.destroy();
+			s->__finish();
+		}
+		pf_decl_constexpr void
+		await_resume() const pf_attr_noexcept
+		{}
+	};
+	template<typename _RetTy>
+	struct __future_promise_base
+	{
+		/// Constructors
+		__future_promise_base()
+			: store(__future_store_new<_RetTy>())
+		{}
+
+		/// Coroutine
+		pf_hint_nodiscard future<_RetTy>
+		get_return_object() pf_attr_noexcept
+		{
+			return this->store;
+		}
+		pf_hint_nodiscard __co_schedule_awaiter
+		initial_suspend() const pf_attr_noexcept
+		{
+			return __co_schedule_awaiter(CCY_TASK_FLAG_NONE);	 // NOTE: Coroutines start on the pool, like submit_future_task
+		}
+		pf_hint_nodiscard __future_promise_final<_RetTy>
+		final_suspend() const pf_attr_noexcept
+		{
+			return __future_promise_final<_RetTy>();
+		}
+		void
+		unhandled_exception() pf_attr_noexcept
+		{
+			this->store->record.set_record(std::current_exception(), nullptr);	// NOTE: No thread is kept waiting on it, the record is copied
+		}
+
+		/// Store
+		__future_store<_RetTy> *store;
+	};
+	template<typename _RetTy>
+	struct __future_promise pf_attr_final : public __future_promise_base<_RetTy>
+	{
+		/// Return
+		template<typename _Uy>
+		void
+		return_value(
+		 _Uy &&__val)
+			requires(std::is_constructible_v<_RetTy, _Uy>)
+		{
+			construct(union_cast<_RetTy *>(&this->store->retVal[0]), std::forward<_Uy>(__val));
+		}
+	};
+	template<>
+	struct __future_promise<void> pf_attr_final : public __future_promise_base<void>
+	{
+		/// Return
+		pf_decl_constexpr void
+		return_void() const pf_attr_noexcept
+		{}
+	};
+
+	/// CONCURRENCY: Task -> Submit
+	/*! @brief Submits __fun(__args...) as one task. When its lane is full, thread_pool_overflow decides:
+	 *				 returns false only under task_overflow::fail, the task is then destroyed without running.
+	 */
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static bool
+	submit_task(
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		if(__task_submit(&t->task, thread_pool_overflow())) return true;
+		__task_discard(t);
+		return false;
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static bool
+	submit_task(
+	 task_priority __priority,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		if(__task_submit(__priority, &t->task, thread_pool_overflow())) return true;
+		__task_discard(t);
+		return false;
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static bool
+	submit_task_0(
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		if(__task_submit_0(&t->task, thread_pool_overflow())) return true;
+		__task_discard(t);
+		return false;
+	}
+
+	/*! @brief Submissions the task system relies on to make progress, never refused nor run inline.
+	 */
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static void
+	__submit_task_always(
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		__task_enqueue(&t->task);
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static void
+	__submit_task_always_0(
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		__task_enqueue_0(&t->task);
+	}
+
+	/*! @brief Submits __fun(__args...) unless the shared queue is full, whatever the overflow policy.
+	 */
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_hint_nodiscard pf_decl_static bool
+	try_submit_task(
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		if(__task_submit(&t->task, task_overflow::fail)) return true;
+		__task_discard(t);
+		return false;
+	}
+
+	/*! @brief Submits a copy of each callable in [__beg, __end) as one task.
+	 *				 Tasks are enqueued by batches of CCY_TASKS_BULK_NUM, each batch costs a single reservation
+	 *				 on the shared queue, a single counter update and wakes at most one worker per task.
+	 *				 Returns the number of tasks submitted, it stops at the first refusal under task_overflow::fail.
+	 */
+	template<typename _IteratorIn>
+	pf_decl_static size_t
+	submit_tasks_bulk(
+	 _IteratorIn __beg,
+	 _IteratorIn __end)
+		requires(is_iterator_v<_IteratorIn> && std::is_invocable_v<std::remove_const_t<value_type_t<_IteratorIn>>>)
+	{
+		using __fun_t		= std::remove_const_t<value_type_t<_IteratorIn>>;
+		using __store_t = __task_store<__fun_t>;
+		const task_overflow p = thread_pool_overflow();
+		__task_t *t[CCY_TASKS_BULK_NUM];
+		size_t r = 0;
+		while(__beg != __end)
+		{
+			size_t n = 0;
+			try
+			{
+				for(; n != CCY_TASKS_BULK_NUM && __beg != __end; ++n, ++__beg)
+				{
+					t[n] = &__task_new<__store_t>(__fun_t(*__beg))->task;
+				}
+			} catch(std::exception const &)
+			{
+				for(size_t i = 0; i != n; ++i) __task_discard(union_cast<__store_t *>(t[i]));	// NOTE: The batch was never enqueued
+				throw;
+			}
+			const size_t k = __task_submit_bulk(&t[0], &t[0] + n, p);
+			if(k != n)
+			{
+				for(size_t i = k; i != n; ++i) __task_discard(union_cast<__store_t *>(t[i]));
+				return r + k;
+			}
+			r += k;
+		}
+		return r;
+	}
+
+	/*! @brief Submits __count tasks, the i-th one calling a copy of __fun with i.
+	 *				 Returns the number of tasks submitted, like submit_tasks_bulk.
+	 */
+	template<typename _FunTy>
+	pf_decl_static size_t
+	submit_task_n(
+	 size_t __count,
+	 _FunTy &&__fun)
+		requires(std::is_invocable_v<_FunTy, size_t>)
+	{
+		using __fun_t		= std::decay_t<_FunTy>;
+		using __store_t = __task_store<__fun_t, size_t>;
+		const task_overflow p = thread_pool_overflow();
+		__task_t *t[CCY_TASKS_BULK_NUM];
+		size_t i = 0;
+		while(i != __count)
+		{
+			size_t n = 0;
+			try
+			{
+				for(; n != CCY_TASKS_BULK_NUM && i != __count; ++n, ++i)
+				{
+					t[n] = &__task_new<__store_t>(__fun_t(__fun), size_t(i))->task;
+				}
+			} catch(std::exception const &)
+			{
+				for(size_t j = 0; j != n; ++j) __task_discard(union_cast<__store_t *>(t[j]));	// NOTE: The batch was never enqueued
+				throw;
+			}
+			const size_t k = __task_submit_bulk(&t[0], &t[0] + n, p);
+			if(k != n)
+			{
+				for(size_t j = k; j != n; ++j) __task_discard(union_cast<__store_t *>(t[j]));
+				return i - (n - k);
+			}
+		}
+		return __count;
+	}
+
+	/*! @brief Future submissions throw once refused under task_overflow::fail, a future must complete.
+	 */
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_hint_nodiscard pf_decl_static future<std::invoke_result_t<_FunTy, _Args...>>
+	submit_future_task(
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+		try
+		{
+			auto *t = __task_new<__task_store_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
+			if(!__task_submit(&t->task, thread_pool_overflow()))
+			{
+				__task_discard(t);
+				pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Future task refused, the shared queue is full.");
+			}
+			return s;
+		} catch(std::exception const &)
+		{
+			__future_store_delete(s);
+			throw;
+		}
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_hint_nodiscard pf_decl_static future<std::invoke_result_t<_FunTy, _Args...>>
+	submit_future_task(
+	 task_priority __priority,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+		try
+		{
+			auto *t = __task_new<__task_store_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
+			if(!__task_submit(__priority, &t->task, thread_pool_overflow()))
+			{
+				__task_discard(t);
+				pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Future task refused, the priority lane is full. priority={}", static_cast<uint32_t>(__priority));
+			}
+			return s;
+		} catch(std::exception const &)
+		{
+			__future_store_delete(s);
+			throw;
+		}
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_hint_nodiscard pf_decl_static future<std::invoke_result_t<_FunTy, _Args...>>
+	submit_future_task_0(
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+		try
+		{
+			auto *t = __task_new<__task_store_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
+			if(!__task_submit_0(&t->task, thread_pool_overflow()))
+			{
+				__task_discard(t);
+				pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Future task refused, the main queue is full.");
+			}
+			return s;
+		} catch(std::exception const &)
+		{
+			__future_store_delete(s);
+			throw;
+		}
+	}
+
+	/*! @brief Same as above, the task is dropped without calling __fun if __token is cancelled before it starts.
+	 *				 The future then finishes as cancelled, a running task may poll its own copy of the token.
+	 */
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_hint_nodiscard pf_decl_static future<std::invoke_result_t<_FunTy, _Args...>>
+	submit_future_task(
+	 cancel_token const &__token,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+		try
+		{
+			auto *t = __task_new<__task_store_fc<_FunTy, _Args...>>(__token, s, std::move(__fun), std::forward<_Args>(__args)...);
+			if(!__task_submit(&t->task, thread_pool_overflow()))
+			{
+				__task_discard(t);
+				pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Future task refused, the shared queue is full.");
+			}
+			return s;
+		} catch(std::exception const &)
+		{
+			__future_store_delete(s);
+			throw;
+		}
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_hint_nodiscard pf_decl_static future<std::invoke_result_t<_FunTy, _Args...>>
+	submit_future_task_0(
+	 cancel_token const &__token,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+		try
+		{
+			auto *t = __task_new<__task_store_fc<_FunTy, _Args...>>(__token, s, std::move(__fun), std::forward<_Args>(__args)...);
+			if(!__task_submit_0(&t->task, thread_pool_overflow()))
+			{
+				__task_discard(t);
+				pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Future task refused, the main queue is full.");
+			}
+			return s;
+		} catch(std::exception const &)
+		{
+			__future_store_delete(s);
+			throw;
+		}
+	}
+
+	/// CONCURRENCY: Task -> Timer
+	/*! @brief Enqueues __task once __at is reached, on the main thread queue when CCY_TASK_FLAG_0 is set.
+	 *				 Timers live in a hierarchical timing wheel with a 1ms resolution, they never fire early.
+	 *				 The wheel owns __task from then on, __discard frees it if it never fires: at shutdown,
+	 *				 when scheduled after it, or when the timer can't be allocated.
+	 */
+	pulsar_api void
+	__timer_schedule(
+	 __task_t *__task,
+	 high_resolution_point_t __at,
+	 __task_discard_fun_t __discard);
+	pf_hint_nodiscard pulsar_api size_t
+	timer_num_pending() pf_attr_noexcept;
+
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static void
+	submit_task_at(
+	 high_resolution_point_t __at,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		__timer_schedule(&t->task, __at, __task_discard_as<__task_store<_FunTy, _Args...>>);
+	}
+	template<
+	 typename _Rep,
+	 typename _Period,
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static void
+	submit_task_after(
+	 duration<_Rep, _Period> __delay,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		submit_task_at(
+		 high_resolution_clock_t::now() + duration_cast<high_resolution_clock_t::duration>(__delay),
+		 std::forward<_FunTy>(__fun),
+		 std::forward<_Args>(__args)...);
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static void
+	submit_task_0_at(
+	 high_resolution_point_t __at,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+		t->task.flags_ |= CCY_TASK_FLAG_0;
+		__timer_schedule(&t->task, __at, __task_discard_as<__task_store<_FunTy, _Args...>>);
+	}
+	template<
+	 typename _Rep,
+	 typename _Period,
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_static void
+	submit_task_0_after(
+	 duration<_Rep, _Period> __delay,
+	 _FunTy &&__fun,
+	 _Args &&...__args)
+		requires(std::is_invocable_v<_FunTy, _Args...>)
+	{
+		submit_task_0_at(
+		 high_resolution_clock_t::now() + duration_cast<high_resolution_clock_t::duration>(__delay),
+		 std::forward<_FunTy>(__fun),
+		 std::forward<_Args>(__args)...);
+	}
+
+	/// CONCURRENCY: Task -> Timer -> Periodic
+	template<typename _FunTy>
+	struct __timer_periodic_store
+	{
+		/// Constructors
+		__timer_periodic_store(
+		 _FunTy &&__fun,
+		 high_resolution_clock_t::duration __period,
+		 uint32_t __flags)
+			: task(__proc, CCY_TASK_FLAG_PERSISTENT | __flags)
+			, period(__period)
+			, next(high_resolution_clock_t::now() + __period)
+			, fun(std::move(__fun))
+		{}
+		__timer_periodic_store(__timer_periodic_store<_FunTy> const &) = delete;
+		__timer_periodic_store(__timer_periodic_store<_FunTy> &&)			 = delete;
+
+		/// Destructor
+		~__timer_periodic_store() pf_attr_noexcept = default;
+
+		/// Operator =
+		__timer_periodic_store<_FunTy> &
+		operator=(__timer_periodic_store<_FunTy> const &) = delete;
+		__timer_periodic_store<_FunTy> &
+		operator=(__timer_periodic_store<_FunTy> &&) = delete;
+
+		/// Delete
+		pf_decl_static void
+		__delete(
+		 __timer_periodic_store<_FunTy> *__store) pf_attr_noexcept
+		{
+			destroy(__store);
+			__task_slab_free(__store);
+		}
+
+		/// Process
+		pf_decl_static void
+		__proc(
+		 void *__data)
+		{
+			auto *s = union_cast<__timer_periodic_store<_FunTy> *>(union_cast<__task_t *>(__data) - 1);
+
+			// Run
+			bool again = true;
+			try
+			{
+				if pf_decl_constexpr(std::is_same_v<std::invoke_result_t<_FunTy>, bool>)
+					again = s->fun();
+				else
+					s->fun();
+			} catch(std::exception const &)
+			{
+				__delete(s);
+				throw;
+			}
+			if(!again)
+			{
+				__delete(s);
+				return;
+			}
+
+			// Rearm -> Fixed rate, missed periods are skipped
+			s->next						 += s->period;
+			const auto now	= high_resolution_clock_t::now();
+			if(s->next <= now) s->next += s->period * ((now - s->next) / s->period + 1);
+			__timer_schedule(&s->task, s->next, __task_discard_as<__timer_periodic_store<_FunTy>>);
+		}
+
+		/// Store
+		__task_t task;
+		const high_resolution_clock_t::duration period;
+		high_resolution_point_t next;
+		_FunTy fun;
+	};
+
+	/*! @brief Runs __fun every __period, first after one period. When __fun returns a bool,
+	 *				 returning false stops it, otherwise it runs until shutdown. Runs never overlap.
+	 *				 Throws if __period isn't positive once converted to the clock's resolution.
+	 */
+	template<
+	 typename _Rep,
+	 typename _Period,
+	 typename _FunTy>
+	pf_decl_static void
+	submit_task_every(
+	 duration<_Rep, _Period> __period,
+	 _FunTy &&__fun)
+		requires(std::is_invocable_v<_FunTy>)
+	{
+		const auto p = duration_cast<high_resolution_clock_t::duration>(__period);
+		pf_throw_if(
+		 p <= high_resolution_clock_t::duration::zero(),
+		 dbg_category_generic(),
+		 dbg_code::invalid_argument,
+		 dbg_flags::none,
+		 "The period of a periodic task must be positive! period={}ns",
+		 duration_cast<nanoseconds_t>(__period).count());
+		auto *s = __task_new<__timer_periodic_store<std::decay_t<_FunTy>>>(
+		 std::decay_t<_FunTy>(std::forward<_FunTy>(__fun)), p, CCY_TASK_FLAG_NONE);
+		__timer_schedule(&s->task, s->next, __task_discard_as<__timer_periodic_store<std::decay_t<_FunTy>>>);
+	}
+	template<
+	 typename _Rep,
+	 typename _Period,
+	 typename _FunTy>
+	pf_decl_static void
+	submit_task_0_every(
+	 duration<_Rep, _Period> __period,
+	 _FunTy &&__fun)
+		requires(std::is_invocable_v<_FunTy>)
+	{
+		const auto p = duration_cast<high_resolution_clock_t::duration>(__period);
+		pf_throw_if(
+		 p <= high_resolution_clock_t::duration::zero(),
+		 dbg_category_generic(),
+		 dbg_code::invalid_argument,
+		 dbg_flags::none,
+		 "The period of a periodic task must be positive! period={}ns",
+		 duration_cast<nanoseconds_t>(__period).count());
+		auto *s = __task_new<__timer_periodic_store<std::decay_t<_FunTy>>>(
+		 std::decay_t<_FunTy>(std::forward<_FunTy>(__fun)), p, CCY_TASK_FLAG_0);
+		__timer_schedule(&s->task, s->next, __task_discard_as<__timer_periodic_store<std::decay_t<_FunTy>>>);
+	}
+
+	/// CONCURRENCY: Thread Pool -> Instance
+	class __thread_pool_t;
+	pf_hint_nodiscard pulsar_api __thread_pool_t *
+	__thread_pool_new(
+	 uint32_t __numWorkers,
+	 size_t __capacity);
+	pulsar_api void
+	__thread_pool_delete(
+	 __thread_pool_t *__pool) pf_attr_noexcept;
+	pulsar_api bool
+	__thread_pool_enqueue(
+	 __thread_pool_t *__pool,
+	 __task_t *__task);
+	pulsar_api bool
+	__thread_pool_process(
+	 __thread_pool_t *__pool);
+	pf_hint_nodiscard pulsar_api uint32_t
+	__thread_pool_num_workers(
+	 __thread_pool_t *__pool) pf_attr_noexcept;
+	pulsar_api void
+	__thread_pool_resize(
+	 __thread_pool_t *__pool,
+	 uint32_t __numWorkers);
+	pf_hint_nodiscard pulsar_api uint32_t
+	__thread_pool_num_pending(
+	 __thread_pool_t *__pool) pf_attr_noexcept;
+	pf_hint_nodiscard pulsar_api task_overflow
+	__thread_pool_overflow(
+	 __thread_pool_t *__pool) pf_attr_noexcept;
+	pulsar_api void
+	__thread_pool_set_overflow(
+	 __thread_pool_t *__pool,
+	 task_overflow __policy) pf_attr_noexcept;
+
+	/*! @brief Pool with its own workers and queues, isolated from the global one.
+	 *				 Useful to keep blocking work (IO, ...) away from compute tasks.
+	 *				 Continuations and coroutines resumed from its futures run on the global pool.
+	 */
+	class thread_pool_t
+	{
+	public:
+		/// Constructors
+		thread_pool_t(
+		 uint32_t __numWorkers = CCY_NUM_WORKERS,
+		 size_t __capacity		 = 0)
+			: pool_(__thread_pool_new(__numWorkers, __capacity))
+		{}
+		thread_pool_t(thread_pool_t const &) = delete;
+		thread_pool_t(
+		 thread_pool_t &&__r) pf_attr_noexcept
+			: pool_(__r.pool_)
+		{
+			__r.pool_ = nullptr;
+		}
+
+		/// Destructor
+		~thread_pool_t() pf_attr_noexcept
+		{
+			if(this->pool_) __thread_pool_delete(this->pool_);
+		}
+
+		/// Operator =
+		thread_pool_t &
+		operator=(thread_pool_t const &) = delete;
+		thread_pool_t &
+		operator=(
+		 thread_pool_t &&__r) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__r))
+			{
+				if(this->pool_) __thread_pool_delete(this->pool_);
+				this->pool_ = __r.pool_;
+				__r.pool_		= nullptr;
+			}
+			return *this;
+		}
+
+		/// Submit
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		bool
+		submit_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args)
+			requires(std::is_invocable_v<_FunTy, _Args...>)
+		{
+			auto *t = __task_new<__task_store<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+			if(__thread_pool_enqueue(this->pool_, &t->task)) return true;
+			__task_discard(t);
+			return false;
+		}
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
+		submit_future_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args)
+			requires(std::is_invocable_v<_FunTy, _Args...>)
+		{
+			auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+			try
+			{
+				auto *t = __task_new<__task_store_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
+				if(!__thread_pool_enqueue(this->pool_, &t->task))
+				{
+					__task_discard(t);
+					pf_throw(dbg_category_generic(), dbg_code::runtime_error, 0, "Future task refused, the shared queue is full.");
+				}
+				return s;
+			} catch(std::exception const &)
+			{
+				__future_store_delete(s);
+				throw;
+			}
+		}
+
+		/// Process
+		bool
+		process_tasks()
+		{
+			return __thread_pool_process(this->pool_);
+		}
+
+		/// Workers
+		pf_hint_nodiscard uint32_t
+		num_workers() const pf_attr_noexcept
+		{
+			return __thread_pool_num_workers(this->pool_);
+		}
+		void
+		resize(
+		 uint32_t __numWorkers)
+		{
+			__thread_pool_resize(this->pool_, __numWorkers);
+		}
+
+		/// Backpressure
+		pf_hint_nodiscard uint32_t
+		num_pending() const pf_attr_noexcept
+		{
+			return __thread_pool_num_pending(this->pool_);
+		}
+		pf_hint_nodiscard task_overflow
+		overflow() const pf_attr_noexcept
+		{
+			return __thread_pool_overflow(this->pool_);
+		}
+		void
+		set_overflow(
+		 task_overflow __policy) pf_attr_noexcept
+		{
+			__thread_pool_set_overflow(this->pool_, __policy);
+		}
+
+	private:
+		__thread_pool_t *pool_;
+	};
+
+	/// CONCURRENCY: Task -> Pool
+	struct __task_pool_store_t
+	{
+		/// Type -> Node
+		struct __node_t
+		{
+			__node_t *next;
+			__task_t task;
+		};
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		struct __node_data
+		{
+			/// Constructors
+			__node_data(
+			 _FunTy &&__fun,
+			 _Args &&...__args)
+				: next(nullptr)
+				, data(std::move(__fun), std::forward<_Args>(__args)...)
+			{}
+			__node_data(
+			 __node_data<_FunTy, _Args...> const &) = delete;
+			__node_data(
+			 __node_data<_FunTy, _Args...> &&) = delete;
+
+			/// Destructor
+			~__node_data() pf_attr_noexcept = default;
+
+			/// Operator =
+			__node_data<_FunTy, _Args...> &
+			operator=(__node_data<_FunTy, _Args...> const &) = delete;
+			__node_data<_FunTy, _Args...> &
+			operator=(__node_data<_FunTy, _Args...> &&) = delete;
+
+			/// Store
+			__node_t *next;
+			__task_store<_FunTy, _Args...> data;
+		};
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		struct __node_data_f
+		{
+			/// Constructors
+			__node_data_f(
+			 __future_store<std::invoke_result_t<_FunTy, _Args...>> *__s,
+			 _FunTy &&__fun,
+			 _Args &&...__args)
+				: next(nullptr)
+				, data(__s, std::move(__fun), std::forward<_Args>(__args)...)
+			{}
+			__node_data_f(
+			 __node_data_f<_FunTy, _Args...> const &) = delete;
+			__node_data_f(
 			 __node_data_f<_FunTy, _Args...> &&) = delete;
 
-			/// Destructor
-			~__node_data_f() pf_attr_noexcept = default;
+			/// Destructor
+			~__node_data_f() pf_attr_noexcept = default;
+
+			/// Operator =
+			__node_data_f<_FunTy, _Args...> &
+			operator=(__node_data_f<_FunTy, _Args...> const &) = delete;
+			__node_data_f<_FunTy, _Args...> &
+			operator=(__node_data_f<_FunTy, _Args...> &&) = delete;
+
+			/// Store
+			__node_t *next;
+			__task_store_f<_FunTy, _Args...> data;
+		};
+
+		/// Constructors
+		__task_pool_store_t() pf_attr_noexcept
+			: numTasks(0)
+		{}
+		__task_pool_store_t(__task_pool_store_t const &) = delete;
+		__task_pool_store_t(__task_pool_store_t &&)			 = delete;
+
+		/// Destructor
+		~__task_pool_store_t() pf_attr_noexcept
+		{
+			this->__wait();
+		}
+
+		/// Operator =
+		__task_pool_store_t &
+		operator=(__task_pool_store_t const &) = delete;
+		__task_pool_store_t &
+		operator=(__task_pool_store_t &&) = delete;
+
+		/// Process
+		pf_hint_nodiscard pf_decl_static uint32_t
+		__process(
+		 __task_pool_store_t *__store)
+		{
+			uint32_t k = 0;
+			auto *t		 = __store->pool.dequeue();
+			while(t)
+			{
+				++k;
+				auto *n = t->next;
+				try
+				{
+					t->task.__call();
+				} catch(std::exception const &)
+				{
+					__store->numTasks.fetch_sub(k, atomic_order::relaxed);
+					destroy_delete_c(t);
+					throw;
+				}
+				destroy_delete_c(t);
+				t = n;
+			}
+			return (__store->numTasks.fetch_sub(k, atomic_order::relaxed) - k);
+		}
+		pf_decl_static void
+		__process_auto_submit(
+		 __task_pool_store_t *__store) pf_attr_noexcept
+		{
+			if(__process(__store) > 0)
+			{
+				__submit_task_always(__process_auto_submit, __store);
+			}
+		}
+		pf_decl_static void
+		__process_auto_submit_0(
+		 __task_pool_store_t *__store)
+		{
+			if(__process(__store) > 0)
+			{
+				__submit_task_always(__process_auto_submit_0, __store);
+			}
+		}
+
+		/// Submit
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		void
+		__submit_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			auto *n = new_construct_c<__node_data<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			{
+				__submit_task_always(__process_auto_submit, this);
+			}
+			this->pool.enqueue(union_cast<__node_t *>(n));
+		}
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		void
+		__submit_task_0(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			auto *n = new_construct_c<__node_data<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			{
+				__submit_task_always_0(__process_auto_submit_0, this);
+			}
+			this->pool.enqueue(union_cast<__node_t *>(n));
+		}
+
+		/// Submit Future
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
+		__submit_future_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+			auto *n = new_construct_c<__node_data_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
+			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			{
+				__submit_task_always(__process_auto_submit, this);
+			}
+			this->pool.enqueue(union_cast<__node_t *>(n));
+			return s;
+		}
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
+		__submit_future_task_0(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+			auto *n = new_construct_c<__node_data_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
+			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			{
+				__submit_task_always_0(__process_auto_submit_0, this);
+			}
+			this->pool.enqueue(union_cast<__node_t *>(n));
+			return s;
+		}
+
+		/// Finished
+		pf_hint_nodiscard bool
+		__is_finished() const pf_attr_noexcept
+		{
+			return this->numTasks.load(atomic_order::relaxed) == 0;
+		}
+
+		/// Wait
+		bool
+		__wait() const pf_attr_noexcept
+		{
+			// No need to wait
+			if(numTasks.load(atomic_order::relaxed) == 0) return false;
+
+			// Have to wait
+			__task_wait_until(
+			 [this]()
+			 { return this->numTasks.load(atomic_order::relaxed) == 0; });
+			return true;
+		}
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> numTasks;
+		mpsc_singly_lifo<__node_t> pool;
+	};
+	class task_pool_t pf_attr_final
+	{
+	public:
+		/// Constructors
+		task_pool_t()
+			: buf_(new_construct<__task_pool_store_t>())
+		{}
+		task_pool_t(task_pool_t const &) = delete;
+		task_pool_t(task_pool_t &&__r)
+			: buf_(__r.buf_)
+		{
+			__r.buf_ = nullptr;
+		}
+
+		/// Destructor
+		~task_pool_t() pf_attr_noexcept
+		{
+			this->wait();
+			if(this->buf_) destroy_delete(this->buf_);
+		}
+
+		/// Operator =
+		task_pool_t &
+		operator=(
+		 task_pool_t const &) = delete;
+		task_pool_t &
+		operator=(
+		 task_pool_t &&__r) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__r))
+			{
+				if(this->buf_) destroy_delete(this->buf_);
+				this->buf_ = __r.buf_;
+				__r.buf_	 = nullptr;
+			}
+			return *this;
+		}
+
+		/// Submit
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		void
+		submit_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			this->buf_->__submit_task(std::move(__fun), std::forward<_Args>(__args)...);
+		}
+
+		/// Submit Future
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
+		submit_future_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+			requires(std::is_invocable_v<_FunTy, _Args...>)
+		{
+			return this->buf_->__submit_future_task(std::move(__fun), std::forward<_Args>(__args)...);
+		}
+
+		/// Finished
+		pf_hint_nodiscard bool
+		is_finished() const pf_attr_noexcept
+		{
+			return this->buf_->__is_finished();
+		}
+
+		/// Wait
+		bool
+		wait() const pf_attr_noexcept
+		{
+			return this->buf_->__wait();
+		}
+
+	private:
+		/// Store
+		__task_pool_store_t *buf_;
+	};
+
+	/// CONCURRENCY: Task -> Pool
+	class task_pool_0_t pf_attr_final
+	{
+	public:
+		/// Constructors
+		task_pool_0_t()
+			: buf_(new_construct<__task_pool_store_t>())
+		{}
+		task_pool_0_t(task_pool_0_t const &) = delete;
+		task_pool_0_t(task_pool_0_t &&__r)
+			: buf_(__r.buf_)
+		{
+			__r.buf_ = nullptr;
+		}
+
+		/// Destructor
+		~task_pool_0_t() pf_attr_noexcept
+		{
+			this->wait();
+			if(this->buf_) destroy_delete(this->buf_);
+		}
+
+		/// Operator =
+		task_pool_0_t &
+		operator=(
+		 task_pool_0_t const &) = delete;
+		task_pool_0_t &
+		operator=(
+		 task_pool_0_t &&__r) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__r))
+			{
+				if(this->buf_) destroy_delete(this->buf_);
+				this->buf_ = __r.buf_;
+				__r.buf_	 = nullptr;
+			}
+			return *this;
+		}
+
+		/// Submit
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		void
+		submit_task_0(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			this->buf_->__submit_task_0(std::move(__fun), std::forward<_Args>(__args)...);
+		}
+
+		/// Submit Future
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
+		submit_future_task_0(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+			requires(std::is_invocable_v<_FunTy, _Args...>)
+		{
+			return this->buf_->__submit_future_task_0(std::move(__fun), std::forward<_Args>(__args)...);
+		}
+
+		/// Finished
+		pf_hint_nodiscard bool
+		is_finished() const pf_attr_noexcept
+		{
+			return this->buf_->__is_finished();
+		}
+
+		/// Wait
+		bool
+		wait() const pf_attr_noexcept
+		{
+			return this->buf_->__wait();
+		}
+
+	private:
+		/// Store
+		__task_pool_store_t *buf_;
+	};
+
+	/// CONCURRENCY: Task -> Strand
+	pf_decl_constexpr uint32_t CCY_STRAND_BATCH_SIZE = 64;	// NOTE: Tasks run per drain before yielding the worker back to the pool
+
+	/*! @brief Serial executor. Tasks are pushed on a lock-free inbox and a single drain task, scheduled
+	 *				 by the submitter that moves the count from 0, runs them one at a time in FIFO order on any
+	 *				 worker, by batches of CCY_STRAND_BATCH_SIZE. A throwing task doesn't stop the following ones.
+	 */
+	struct __strand_store_t
+	{
+		/// Type -> Node
+		using __node_t = __task_pool_store_t::__node_t;
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		using __node_data = __task_pool_store_t::__node_data<_FunTy, _Args...>;
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		using __node_data_f = __task_pool_store_t::__node_data_f<_FunTy, _Args...>;
+
+		/// Constructors
+		__strand_store_t() pf_attr_noexcept
+			: numTasks(0)
+			, inbox(nullptr)
+			, batch(nullptr)
+		{}
+		__strand_store_t(__strand_store_t const &) = delete;
+		__strand_store_t(__strand_store_t &&)			 = delete;
+
+		/// Destructor
+		~__strand_store_t() pf_attr_noexcept
+		{
+			this->__wait();
+		}
+
+		/// Operator =
+		__strand_store_t &
+		operator=(__strand_store_t const &) = delete;
+		__strand_store_t &
+		operator=(__strand_store_t &&) = delete;
+
+		/// Process
+		pf_decl_static void
+		__process(
+		 __strand_store_t *__store) pf_attr_noexcept
+		{
+			uint32_t k = 0;
+			while(k != CCY_STRAND_BATCH_SIZE)
+			{
+				// Inbox -> Batch, reversed to submission order
+				if(!__store->batch)
+				{
+					__node_t *n = __store->inbox.exchange(nullptr, atomic_order::acquire);
+					while(n)
+					{
+						__node_t *x		 = n->next;
+						n->next				 = __store->batch;
+						__store->batch = n;
+						n							 = x;
+					}
+					if(!__store->batch) break;
+				}
+
+				// Run
+				__node_t *t		 = __store->batch;
+				__store->batch = t->next;
+				++k;
+				try
+				{
+					t->task.__call();
+				} catch(std::exception const &)
+				{
+					__dbg_move_exception_record_to_0();
+				}
+				destroy_delete_c(t);
+			}
+
+			// Remaining -> Resubmit
+			// NOTE: A task may be counted but not pushed yet, the next drain will pick it up
+			if(__store->numTasks.fetch_sub(k, atomic_order::acq_rel) != k)
+			{
+				__submit_task_always(__process, __store);
+			}
+		}
+
+		/// Push
+		pf_decl_inline void
+		__push(
+		 __node_t *__node) pf_attr_noexcept
+		{
+			const bool first = this->numTasks.fetch_add(1, atomic_order::acq_rel) == 0;
+			__node->next		 = this->inbox.load(atomic_order::relaxed);
+			while(!this->inbox.compare_exchange_weak(__node->next, __node, atomic_order::release, atomic_order::relaxed))
+				;
+			if(first) __submit_task_always(__process, this);	// NOTE: Pushed first, the drain always finds it
+		}
+
+		/// Submit
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		void
+		__submit_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			auto *n = new_construct_c<__node_data<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
+			this->__push(union_cast<__node_t *>(n));
+		}
+
+		/// Submit Future
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
+		__submit_future_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			auto *s = __future_store_new<std::invoke_result_t<_FunTy, _Args...>>();
+			auto *n = new_construct_c<__node_data_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
+			this->__push(union_cast<__node_t *>(n));
+			return s;
+		}
+
+		/// Finished
+		pf_hint_nodiscard bool
+		__is_finished() const pf_attr_noexcept
+		{
+			return this->numTasks.load(atomic_order::acquire) == 0;
+		}
+
+		/// Wait
+		bool
+		__wait() const pf_attr_noexcept
+		{
+			// No need to wait
+			if(this->numTasks.load(atomic_order::acquire) == 0) return false;
+
+			// Have to wait
+			__task_wait_until(
+			 [this]()
+			 { return this->numTasks.load(atomic_order::acquire) == 0; });
+			return true;
+		}
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<size_t> numTasks;
+		pf_alignas(CCY_ALIGN) atomic<__node_t *> inbox;
+		pf_alignas(CCY_ALIGN) __node_t *batch;	// NOTE: Owned by the running drain
+	};
+	class strand_t pf_attr_final
+	{
+	public:
+		/// Constructors
+		strand_t()
+			: buf_(new_construct<__strand_store_t>())
+		{}
+		strand_t(strand_t const &) = delete;
+		strand_t(strand_t &&__r)
+			: buf_(__r.buf_)
+		{
+			__r.buf_ = nullptr;
+		}
+
+		/// Destructor
+		~strand_t() pf_attr_noexcept
+		{
+			if(this->buf_) destroy_delete(this->buf_);
+		}
+
+		/// Operator =
+		strand_t &
+		operator=(
+		 strand_t const &) = delete;
+		strand_t &
+		operator=(
+		 strand_t &&__r) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__r))
+			{
+				if(this->buf_) destroy_delete(this->buf_);
+				this->buf_ = __r.buf_;
+				__r.buf_	 = nullptr;
+			}
+			return *this;
+		}
+
+		/// Submit
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		void
+		submit_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+		{
+			this->buf_->__submit_task(std::move(__fun), std::forward<_Args>(__args)...);
+		}
+
+		/// Submit Future
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
+		submit_future_task(
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+			requires(std::is_invocable_v<_FunTy, _Args...>)
+		{
+			return this->buf_->__submit_future_task(std::move(__fun), std::forward<_Args>(__args)...);
+		}
+
+		/// Finished
+		pf_hint_nodiscard bool
+		is_finished() const pf_attr_noexcept
+		{
+			return this->buf_->__is_finished();
+		}
+
+		/// Wait
+		bool
+		wait() const pf_attr_noexcept
+		{
+			return this->buf_->__wait();
+		}
+
+	private:
+		/// Store
+		__strand_store_t *buf_;
+	};
+
+	/// CONCURRENCY: Task -> Group
+	/*! @brief Fork-join scope. Tasks run on the pool from slab-allocated stores, their exceptions are
+	 *				 caught and the first one is rethrown by wait(), which executes pending work meanwhile.
+	 */
+	struct __task_group_store_t
+	{
+		/// Constructors
+		__task_group_store_t() pf_attr_noexcept
+			: numTasks(0)
+			, numExceptions(0)
+		{}
+		__task_group_store_t(__task_group_store_t const &) = delete;
+		__task_group_store_t(__task_group_store_t &&)			 = delete;
+
+		/// Destructor
+		~__task_group_store_t() pf_attr_noexcept = default;
+
+		/// Operator =
+		__task_group_store_t &
+		operator=(__task_group_store_t const &) = delete;
+		__task_group_store_t &
+		operator=(__task_group_store_t &&) = delete;
+
+		/// Exception
+		void
+		__set_exception(
+		 std::exception_ptr &&__ptr) pf_attr_noexcept
+		{
+			if(this->numExceptions.fetch_add(1, atomic_order::relaxed) == 0)
+			{
+				this->exception = std::move(__ptr);	 // NOTE: Published by the release of numTasks
+			}
+		}
+
+		/// Finished
+		pf_hint_nodiscard bool
+		__is_finished() const pf_attr_noexcept
+		{
+			return this->numTasks.load(atomic_order::acquire) == 0;
+		}
+
+		/// Wait
+		bool
+		__wait() const pf_attr_noexcept
+		{
+			// No need to wait
+			if(this->__is_finished()) return false;
+
+			// Have to wait -> Help, the main thread runs its own queue first
+			while(!this->__is_finished())
+			{
+				if(!__task_help()) this_thread::yield();
+			}
+			return true;
+		}
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<size_t> numTasks;
+		atomic<size_t> numExceptions;
+		std::exception_ptr exception;
+	};
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	struct __task_data_g pf_attr_final
+	{
+		/// Constructors
+		__task_data_g(
+		 __task_group_store_t *__group,
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+			: group(__group)
+			, data(std::move(__fun), std::forward<_Args>(__args)...)
+		{}
+		__task_data_g(__task_data_g<_FunTy, _Args...> const &) = delete;
+		__task_data_g(__task_data_g<_FunTy, _Args...> &&)			 = delete;
+
+		/// Destructor
+		~__task_data_g() pf_attr_noexcept = default;
+
+		/// Operator =
+		__task_data_g &
+		operator=(__task_data_g<_FunTy, _Args...> const &) = delete;
+		__task_data_g &
+		operator=(__task_data_g<_FunTy, _Args...> &&) = delete;
+
+		/// Store
+		__task_group_store_t *group;
+		__task_data<_FunTy, _Args...> data;
+	};
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	pf_decl_inline void
+	__task_data_g_proc(
+	 void *__data) pf_attr_noexcept
+	{
+		auto data										= union_cast<__task_data_g<_FunTy, _Args...> *>(__data);
+		__task_group_store_t *group = data->group;
+		try
+		{
+			__task_data_proc<_FunTy, _Args...>(&data->data);
+		} catch(std::exception const &)
+		{
+			group->__set_exception(std::current_exception());
+		}
+		group->numTasks.fetch_sub(1, atomic_order::release);	// NOTE: The group may be gone afterwards
+	}
+	template<
+	 typename _FunTy,
+	 typename... _Args>
+	struct __task_store_g
+	{
+		/// Constructors
+		__task_store_g(
+		 __task_group_store_t *__group,
+		 _FunTy &&__fun,
+		 _Args &&...__args) pf_attr_noexcept
+			: task(__task_data_g_proc<_FunTy, _Args...>)
+			, data(__group, std::move(__fun), std::forward<_Args>(__args)...)
+		{}
+		__task_store_g(__task_store_g<_FunTy, _Args...> const &) = delete;
+		__task_store_g(__task_store_g<_FunTy, _Args...> &&)			 = delete;
+
+		/// Destructor
+		~__task_store_g() pf_attr_noexcept = default;
+
+		/// Operator =
+		__task_store_g<_FunTy, _Args...> &
+		operator=(__task_store_g<_FunTy, _Args...> const &) = delete;
+		__task_store_g<_FunTy, _Args...> &
+		operator=(__task_store_g<_FunTy, _Args...> &&) = delete;
+
+		/// Store
+		__task_t task;
+		__task_data_g<_FunTy, _Args...> data;
+	};
+	class task_group_t pf_attr_final
+	{
+	public:
+		/// Constructors
+		task_group_t() pf_attr_noexcept = default;
+		task_group_t(task_group_t const &) = delete;
+		task_group_t(task_group_t &&)			 = delete;	// NOTE: Running tasks point to the group
+
+		/// Destructor
+		~task_group_t() pf_attr_noexcept
+		{
+			this->store_.__wait();	// NOTE: Unchecked exceptions are dropped
+		}
+
+		/// Operator =
+		task_group_t &
+		operator=(
+		 task_group_t const &) = delete;
+		task_group_t &
+		operator=(
+		 task_group_t &&) = delete;
+
+		/// Run
+		template<
+		 typename _FunTy,
+		 typename... _Args>
+		void
+		run(
+		 _FunTy &&__fun,
+		 _Args &&...__args)
+			requires(std::is_invocable_v<_FunTy, _Args...>)
+		{
+			auto *t = __task_new<__task_store_g<_FunTy, _Args...>>(&this->store_, std::move(__fun), std::forward<_Args>(__args)...);
+			this->store_.numTasks.fetch_add(1, atomic_order::relaxed);
+			__task_enqueue(&t->task);
+		}
 
-			/// Operator =
-			__node_data_f<_FunTy, _Args...> &
-			operator=(__node_data_f<_FunTy, _Args...> const &) = delete;
-			__node_data_f<_FunTy, _Args...> &
-			operator=(__node_data_f<_FunTy, _Args...> &&) = delete;
+		/// Finished
+		pf_hint_nodiscard bool
+		is_finished() const pf_attr_noexcept
+		{
+			return this->store_.__is_finished();
+		}
 
-			/// Store
-			__node_t *next;
-			__task_store_f<_FunTy, _Args...> data;
-		};
+		/// Exceptions
+		/*! @brief Number of tasks that threw before the last wait() returned or rethrew.
+		 */
+		pf_hint_nodiscard size_t
+		num_exceptions() const pf_attr_noexcept
+		{
+			return this->numThrown_;
+		}
+
+		/// Wait
+		/*! @brief Executes pending work until every task of the group finished, then rethrows the first
+		 *				 exception one of them threw, if any. The group can be reused afterwards.
+		 */
+		bool
+		wait()
+		{
+			const bool w		= this->store_.__wait();
+			this->numThrown_ = this->store_.numExceptions.exchange(0, atomic_order::relaxed);
+			if(this->store_.exception)
+			{
+				std::exception_ptr e	 = std::move(this->store_.exception);
+				this->store_.exception = nullptr;
+				std::rethrow_exception(e);
+			}
+			return w;
+		}
+
+	private:
+		/// Store
+		__task_group_store_t store_;
+		size_t numThrown_ = 0;
+	};
 
+	/// CONCURRENCY: Task -> Graph
+	struct __task_graph_node_t;
+	struct __task_graph_store_t
+	{
 		/// Constructors
-		__task_pool_store_t() pf_attr_noexcept
-			: numTasks(0)
+		__task_graph_store_t() pf_attr_noexcept
+			: numPending(0)
+			, failed(false)
+			, acyclic(true)
 		{}
-		__task_pool_store_t(__task_pool_store_t const &) = delete;
-		__task_pool_store_t(__task_pool_store_t &&)			 = delete;
+		__task_graph_store_t(__task_graph_store_t const &) = delete;
+		__task_graph_store_t(__task_graph_store_t &&)			 = delete;
 
 		/// Destructor
-		~__task_pool_store_t() pf_attr_noexcept
+		~__task_graph_store_t() pf_attr_noexcept = default;
+
+		/// Operator =
+		__task_graph_store_t &
+		operator=(__task_graph_store_t const &) = delete;
+		__task_graph_store_t &
+		operator=(__task_graph_store_t &&) = delete;
+
+		/// Fail
+		void
+		__fail(
+		 std::exception_ptr &&__ptr) pf_attr_noexcept
 		{
-			this->__wait();
+			if(!this->failed.exchange(true, atomic_order::relaxed)) this->exception = std::move(__ptr);
 		}
 
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> numPending;
+		atomic<bool> failed;
+		std::exception_ptr exception;
+		sequence<__task_graph_node_t *> nodes;
+		bool acyclic;	 // NOTE: Checked by run() once per change of the edges
+	};
+	struct __task_graph_node_t
+	{
+		/// Type -> Deleter
+		using __deleter_t = fun_ptr<void(__task_graph_node_t *)>;
+
+		/// Constructors
+		__task_graph_node_t(
+		 __task_fun_t __fun,
+		 __deleter_t __deleter,
+		 __task_graph_store_t *__store) pf_attr_noexcept
+			: task(__fun, CCY_TASK_FLAG_PERSISTENT)
+			, numPending(0)
+			, numPredecessors(0)
+			, index(union_cast<uint32_t>(__store->nodes.count()))
+			, store(__store)
+			, deleter(__deleter)
+		{}
+		__task_graph_node_t(__task_graph_node_t const &) = delete;
+		__task_graph_node_t(__task_graph_node_t &&)			 = delete;
+
+		/// Destructor
+		~__task_graph_node_t() pf_attr_noexcept = default;
+
 		/// Operator =
-		__task_pool_store_t &
-		operator=(__task_pool_store_t const &) = delete;
-		__task_pool_store_t &
-		operator=(__task_pool_store_t &&) = delete;
+		__task_graph_node_t &
+		operator=(__task_graph_node_t const &) = delete;
+		__task_graph_node_t &
+		operator=(__task_graph_node_t &&) = delete;
 
-		/// Process
-		pf_hint_nodiscard pf_decl_static uint32_t
-		__process(
-		 __task_pool_store_t *__store)
+		/// Done
+		void
+		__done() pf_attr_noexcept
 		{
-			uint32_t k = 0;
-			auto *t		 = __store->pool.dequeue();
-			while(t)
+			for(auto *s: this->successors)
 			{
-				++k;
-				auto *n = t->next;
-				try
-				{
-					t->task.__call();
-				} catch(std::exception const &)
+				if(s->numPending.fetch_sub(1, atomic_order::acq_rel) == 1)
 				{
-					__store->numTasks.fetch_sub(k, atomic_order::relaxed);
-					destroy_delete_c(t);
-					throw;
+					s->numPending.store(s->numPredecessors, atomic_order::relaxed);	 // NOTE: Re-armed for the next run
+					__task_enqueue(&s->task);
 				}
-				destroy_delete_c(t);
-				t = n;
 			}
-			return (__store->numTasks.fetch_sub(k, atomic_order::relaxed) - k);
+			this->store->numPending.fetch_sub(1, atomic_order::release);
+		}
+
+		/// Store
+		__task_t task;	// NOTE: Must be first, the task proc retrieves the node from it
+		atomic<uint32_t> numPending;
+		uint32_t numPredecessors;
+		uint32_t index;
+		__task_graph_store_t *store;
+		__deleter_t deleter;
+		sequence<__task_graph_node_t *> successors;
+	};
+	pf_hint_nodiscard pf_decl_inline bool
+	__task_graph_is_acyclic(
+	 __task_graph_store_t *__store)
+	{
+		// Kahn -> Every node is released once its predecessors are, the ones left are on a cycle
+		sequence<uint32_t> pending;
+		sequence<__task_graph_node_t *> ready;
+		for(auto *n: __store->nodes)
+		{
+			pending.insert_back(n->numPredecessors);
+			if(n->numPredecessors == 0) ready.insert_back(n);
+		}
+		size_t k = 0;
+		while(!ready.is_empty())
+		{
+			auto *n = ready.back();
+			ready.remove_back();
+			++k;
+			for(auto *s: n->successors)
+			{
+				if(--pending[s->index] == 0) ready.insert_back(s);
+			}
 		}
+		return k == __store->nodes.count();
+	}
+	template<typename _FunTy>
+	struct __task_graph_node pf_attr_final : public __task_graph_node_t
+	{
+		/// Constructors
+		__task_graph_node(
+		 __task_graph_store_t *__store,
+		 _FunTy &&__fun)
+			: __task_graph_node_t(__proc, __delete, __store)
+			, fun(std::move(__fun))
+		{}
+
+		/// Proc
 		pf_decl_static void
-		__process_auto_submit(
-		 __task_pool_store_t *__store) pf_attr_noexcept
+		__proc(
+		 void *__data) pf_attr_noexcept
 		{
-			if(__process(__store) > 0)
+			auto *n = union_cast<__task_graph_node<_FunTy> *>(union_cast<__task_t *>(__data) - 1);
+			try
 			{
-				submit_task(__process_auto_submit, __store);
+				n->fun();
+			} catch(std::exception const &)
+			{
+				n->store->__fail(std::current_exception());
 			}
+			n->__done();
 		}
+
+		/// Delete
 		pf_decl_static void
-		__process_auto_submit_0(
-		 __task_pool_store_t *__store)
+		__delete(
+		 __task_graph_node_t *__node) pf_attr_noexcept
 		{
-			if(__process(__store) > 0)
+			destroy_delete(union_cast<__task_graph_node<_FunTy> *>(__node));
+		}
+
+		/// Store
+		_FunTy fun;
+	};
+	class task_graph_t pf_attr_final
+	{
+	public:
+		/// Constructors
+		task_graph_t()
+			: buf_(new_construct<__task_graph_store_t>())
+		{}
+		task_graph_t(task_graph_t const &) = delete;
+		task_graph_t(task_graph_t &&__r)
+			: buf_(__r.buf_)
+		{
+			__r.buf_ = nullptr;
+		}
+
+		/// Destructor
+		~task_graph_t() pf_attr_noexcept
+		{
+			this->__destroy();
+		}
+
+		/// Operator =
+		task_graph_t &
+		operator=(
+		 task_graph_t const &) = delete;
+		task_graph_t &
+		operator=(
+		 task_graph_t &&__r) pf_attr_noexcept
+		{
+			if(pf_likely(this != &__r))
 			{
-				submit_task(__process_auto_submit_0, __store);
+				this->__destroy();
+				this->buf_ = __r.buf_;
+				__r.buf_	 = nullptr;
 			}
+			return *this;
 		}
 
-		/// Submit
-		template<
-		 typename _FunTy,
-		 typename... _Args>
+		/// Add
+		/*! @brief Adds a node, the returned index is used to declare its dependencies.
+		 */
+		template<typename _FunTy>
+		uint32_t
+		add(
+		 _FunTy &&__fun)
+			requires(std::is_invocable_v<_FunTy>)
+		{
+			pf_assert(this->is_finished(), "Cannot modify a running task graph!");
+			auto *n = new_construct<__task_graph_node<std::remove_cvref_t<_FunTy>>>(this->buf_, std::remove_cvref_t<_FunTy>(std::forward<_FunTy>(__fun)));
+			this->buf_->nodes.insert_back(n);
+			return union_cast<uint32_t>(this->buf_->nodes.count() - 1);
+		}
+
+		/// Precede
+		/*! @brief @a __before must finish before @a __after is released. A cycle makes run() throw.
+		 */
 		void
-		__submit_task(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
+		precede(
+		 uint32_t __before,
+		 uint32_t __after)
 		{
-			auto *n = new_construct_c<__node_data<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
-			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			pf_assert(this->is_finished(), "Cannot modify a running task graph!");
+			auto *b = this->buf_->nodes[__before];
+			auto *a = this->buf_->nodes[__after];
+			b->successors.insert_back(a);
+			++a->numPredecessors;
+			a->numPending.store(a->numPredecessors, atomic_order::relaxed);
+			this->buf_->acyclic = false;
+		}
+
+		/// Run
+		void
+		run()
+		{
+			pf_assert(this->is_finished(), "Task graph is already running!");
+			if(this->buf_->nodes.is_empty()) return;
+			if(!this->buf_->acyclic)
 			{
-				submit_task(__process_auto_submit, this);
+				pf_throw_if(
+				 !__task_graph_is_acyclic(this->buf_),
+				 dbg_category_generic(),
+				 dbg_code::invalid_argument,
+				 dbg_flags::none,
+				 "The task graph has a cycle, it would never finish!");
+				this->buf_->acyclic = true;
+			}
+			this->buf_->numPending.store(union_cast<uint32_t>(this->buf_->nodes.count()), atomic_order::relaxed);
+			for(auto *n: this->buf_->nodes)
+			{
+				if(n->numPredecessors == 0) __task_enqueue(&n->task);
 			}
-			this->pool.enqueue(union_cast<__node_t *>(n));
 		}
-		template<
-		 typename _FunTy,
-		 typename... _Args>
+
+		/// Finished
+		pf_hint_nodiscard bool
+		is_finished() const pf_attr_noexcept
+		{
+			return this->buf_->numPending.load(atomic_order::acquire) == 0;
+		}
+
+		/// Wait
 		void
-		__submit_task_0(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
+		wait()
 		{
-			auto *n = new_construct_c<__node_data<_FunTy, _Args...>>(std::move(__fun), std::forward<_Args>(__args)...);
-			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			while(this->buf_->numPending.load(atomic_order::acquire) != 0)
 			{
-				submit_task_0(__process_auto_submit_0, this);
+				if(!__task_help()) this_thread::yield();
+			}
+			if(this->buf_->failed.exchange(false, atomic_order::relaxed))
+			{
+				std::rethrow_exception(std::move(this->buf_->exception));
 			}
-			this->pool.enqueue(union_cast<__node_t *>(n));
 		}
 
-		/// Submit Future
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
-		__submit_future_task(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
+		/// Count
+		pf_hint_nodiscard size_t
+		count() const pf_attr_noexcept
 		{
-			auto *s = new_construct<__future_store<std::invoke_result_t<_FunTy, _Args...>>>();
-			auto *n = new_construct_c<__node_data_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
-			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			return this->buf_->nodes.count();
+		}
+
+	private:
+		/// Destroy
+		void
+		__destroy() pf_attr_noexcept
+		{
+			if(!this->buf_) return;
+			while(this->buf_->numPending.load(atomic_order::acquire) != 0) if(!__task_help()) this_thread::yield();
+			for(auto *n: this->buf_->nodes) n->deleter(n);
+			destroy_delete(this->buf_);
+			this->buf_ = nullptr;
+		}
+
+		/// Store
+		__task_graph_store_t *buf_;
+	};
+
+	/// CONCURRENCY: Parallel -> Constants
+	pf_decl_constexpr size_t CCY_PARALLEL_CHUNKS = 16;	// Minimal grain is count / (CCY_NUM_THREADS * CCY_PARALLEL_CHUNKS)
+
+	/// CONCURRENCY: Parallel -> Store
+	template<typename _FunTy>
+	struct __parallel_store pf_attr_final
+	{
+		/// Constructors
+		__parallel_store(
+		 size_t __count,
+		 size_t __grain,
+		 _FunTy &&__fun) pf_attr_noexcept
+			: next(0)
+			, numHelpers(0)
+			, failed(false)
+			, count(__count)
+			, grain(__grain)
+			, fun(std::forward<_FunTy>(__fun))
+		{}
+		__parallel_store(__parallel_store<_FunTy> const &) = delete;
+		__parallel_store(__parallel_store<_FunTy> &&)			 = delete;
+
+		/// Destructor
+		~__parallel_store() pf_attr_noexcept = default;
+
+		/// Operator =
+		__parallel_store<_FunTy> &
+		operator=(__parallel_store<_FunTy> const &) = delete;
+		__parallel_store<_FunTy> &
+		operator=(__parallel_store<_FunTy> &&) = delete;
+
+		/// Claim
+		pf_hint_nodiscard bool
+		__claim(
+		 size_t &__b,
+		 size_t &__e) pf_attr_noexcept
+		{
+			size_t b = this->next.load(atomic_order::relaxed);
+			while(b < this->count)
 			{
-				submit_task(__process_auto_submit, this);
+				// Guided: Chunks shrink while the range drains, down to grain
+				const size_t g = std::max(this->grain, (this->count - b) / (2 * CCY_NUM_THREADS));
+				const size_t e = std::min(this->count, b + g);
+				if(this->next.compare_exchange_weak(b, e, atomic_order::relaxed, atomic_order::relaxed))
+				{
+					__b = b;
+					__e = e;
+					return true;
+				}
 			}
-			this->pool.enqueue(union_cast<__node_t *>(n));
-			return s;
+			return false;
 		}
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
-		__submit_future_task_0(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
+
+		/// Run
+		void
+		__run() pf_attr_noexcept
 		{
-			auto *s = new_construct<__future_store<std::invoke_result_t<_FunTy, _Args...>>>();
-			auto *n = new_construct_c<__node_data_f<_FunTy, _Args...>>(s, std::move(__fun), std::forward<_Args>(__args)...);
-			if(this->numTasks.fetch_add(1, atomic_order::relaxed) == 0)
+			size_t b = 0, e = 0;
+			try
+			{
+				while(this->__claim(b, e)) this->fun(b, e);
+			} catch(std::exception const &)
 			{
-				submit_task_0(__process_auto_submit_0, this);
+				if(!this->failed.exchange(true, atomic_order::relaxed)) this->exception = std::current_exception();
+				this->next.store(this->count, atomic_order::relaxed);	 // NOTE: Stops the other participants
 			}
-			this->pool.enqueue(union_cast<__node_t *>(n));
-			return s;
 		}
-
-		/// Finished
-		pf_hint_nodiscard bool
-		__is_finished() const pf_attr_noexcept
+		pf_decl_static void
+		__run_helper(
+		 __parallel_store<_FunTy> *__store) pf_attr_noexcept
 		{
-			return this->numTasks.load(atomic_order::relaxed) == 0;
+			__store->__run();
+			__store->numHelpers.fetch_sub(1, atomic_order::release);
 		}
 
 		/// Wait
-		bool
-		__wait() const pf_attr_noexcept
+		void
+		__wait()
 		{
-			// No need to wait
-			if(numTasks.load(atomic_order::relaxed) == 0) return false;
+			while(this->numHelpers.load(atomic_order::acquire) != 0)
+			{
+				if(!__task_help()) this_thread::yield();
+			}
+			if(this->failed.load(atomic_order::relaxed)) std::rethrow_exception(this->exception);
+		}
 
-			// Have to wait
-			while(numTasks.load(atomic_order::relaxed) != 0) this_thread::yield();
-			return true;
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<size_t> next;
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> numHelpers;
+		atomic<bool> failed;
+		std::exception_ptr exception;
+		const size_t count;
+		const size_t grain;
+		_FunTy fun;
+	};
+
+	/// CONCURRENCY: Parallel -> Run
+	template<typename _FunTy>
+	pf_decl_inline void
+	__parallel_run(
+	 size_t __count,
+	 size_t __grain,
+	 _FunTy &&__fun)
+	{
+		// Chunks
+		if(__count == 0) return;
+		const size_t w = thread_pool_num_workers();
+		const size_t g = __grain != 0 ? __grain : std::max<size_t>(1, __count / ((w + 1) * CCY_PARALLEL_CHUNKS));
+		const size_t n = (__count + g - 1) / g;
+		if(n == 1)
+		{
+			__fun(0, __count);
+			return;
+		}
+
+		// Helpers
+		__parallel_store<_FunTy> s(__count, g, std::forward<_FunTy>(__fun));
+		const size_t h = std::min<size_t>(w, n - 1);
+		try
+		{
+			for(size_t i = 0; i != h; ++i)
+			{
+				s.numHelpers.fetch_add(1, atomic_order::relaxed);
+				if(!submit_task(
+						 [p = &s]()
+						 { __parallel_store<_FunTy>::__run_helper(p); }))
+				{
+					s.numHelpers.fetch_sub(1, atomic_order::relaxed);	 // NOTE: Refused, the caller takes its share
+					break;
+				}
+			}
+		} catch(std::exception const &)
+		{
+			s.numHelpers.fetch_sub(1, atomic_order::relaxed);
+			s.next.store(__count, atomic_order::relaxed);
+			while(s.numHelpers.load(atomic_order::acquire) != 0) if(!__task_help()) this_thread::yield();
+			throw;
 		}
 
-		/// Store
-		pf_alignas(CCY_ALIGN) atomic<uint32_t> numTasks;
-		mpsc_singly_lifo<__node_t> pool;
-	};
-	class task_pool_t pf_attr_final
+		// Caller helps
+		s.__run();
+		s.__wait();
+	}
+
+	/// CONCURRENCY: Parallel -> For
+	template<typename _FunTy>
+	pf_decl_inline void
+	parallel_for(
+	 size_t __beg,
+	 size_t __end,
+	 _FunTy &&__fun,
+	 size_t __grain = 0)
+		requires(std::is_invocable_v<_FunTy, size_t>)
+	{
+		if(__end <= __beg) return;
+		__parallel_run(
+		 __end - __beg,
+		 __grain,
+		 [&](size_t __b, size_t __e)
+		 {
+			for(size_t i = __beg + __b; i != __beg + __e; ++i) __fun(i);
+		});
+	}
+	template<
+	 typename _Iterator,
+	 typename _FunTy>
+	pf_decl_inline void
+	parallel_for(
+	 _Iterator __beg,
+	 _Iterator __end,
+	 _FunTy &&__fun,
+	 size_t __grain = 0)
+		requires(is_sequence_iterator_v<_Iterator>)
+	{
+		auto *p = __beg.get();
+		__parallel_run(
+		 countof(__beg, __end),
+		 __grain,
+		 [&](size_t __b, size_t __e)
+		 {
+			for(size_t i = __b; i != __e; ++i) __fun(p[i]);
+		});
+	}
+	template<
+	 typename _Iterable,
+	 typename _FunTy>
+	pf_decl_inline void
+	parallel_for(
+	 _Iterable &__iterable,
+	 _FunTy &&__fun,
+	 size_t __grain = 0)
+		requires(is_iterable_v<_Iterable> && is_sequence_iterator_v<typename _Iterable::iterator_t>)
+	{
+		parallel_for(__iterable.begin(), __iterable.end(), std::forward<_FunTy>(__fun), __grain);
+	}
+
+	/// CONCURRENCY: Parallel -> Reduce
+	template<typename _Ty>
+	struct __parallel_partial pf_attr_final
 	{
-	public:
 		/// Constructors
-		task_pool_t()
-			: buf_(new_construct<__task_pool_store_t>())
+		__parallel_partial() pf_attr_noexcept
+			: set(false)
 		{}
-		task_pool_t(task_pool_t const &) = delete;
-		task_pool_t(task_pool_t &&__r)
-			: buf_(__r.buf_)
-		{
-			__r.buf_ = nullptr;
-		}
+		__parallel_partial(__parallel_partial<_Ty> const &) = delete;
+		__parallel_partial(__parallel_partial<_Ty> &&)			= delete;
 
 		/// Destructor
-		~task_pool_t() pf_attr_noexcept
+		~__parallel_partial() pf_attr_noexcept
 		{
-			this->wait();
-			if(this->buf_) destroy_delete(this->buf_);
+			if(this->set) destroy(this->__get());
 		}
 
 		/// Operator =
-		task_pool_t &
-		operator=(
-		 task_pool_t const &) = delete;
-		task_pool_t &
-		operator=(
-		 task_pool_t &&__r) pf_attr_noexcept
-		{
-			if(pf_likely(this != &__r))
-			{
-				if(this->buf_) destroy_delete(this->buf_);
-				this->buf_ = __r.buf_;
-				__r.buf_	 = nullptr;
-			}
-			return *this;
-		}
+		__parallel_partial<_Ty> &
+		operator=(__parallel_partial<_Ty> const &) = delete;
+		__parallel_partial<_Ty> &
+		operator=(__parallel_partial<_Ty> &&) = delete;
 
-		/// Submit
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		void
-		submit_task(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
+		/// Get
+		pf_hint_nodiscard _Ty *
+		__get() pf_attr_noexcept
 		{
-			this->buf_->__submit_task(std::move(__fun), std::forward<_Args>(__args)...);
+			return union_cast<_Ty *>(&this->value[0]);
 		}
 
-		/// Submit Future
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
-		submit_future_task(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
-			requires(std::is_invocable_v<_FunTy, _Args...>)
+		/// Store
+		pf_alignas(CCY_ALIGN) bool set;	 // NOTE: One cache line per thread
+		pf_alignas(alignof(_Ty)) byte_t value[sizeof(_Ty)];
+	};
+
+	/*! @brief The operation must be associative and commutative, chunks are combined in any order.
+	 *				 Each thread folds its chunks into its own partial, the partials are combined once at the end.
+	 */
+	template<
+	 typename _Iterator,
+	 typename _Ty,
+	 typename _BinaryOperation>
+	pf_hint_nodiscard pf_decl_inline _Ty
+	parallel_reduce(
+	 _Iterator __beg,
+	 _Iterator __end,
+	 _Ty __val,
+	 _BinaryOperation &&__op,
+	 size_t __grain = 0)
+		requires(is_sequence_iterator_v<_Iterator> && std::is_invocable_v<_BinaryOperation, _Ty &&, typename _Iterator::value_t &>)
+	{
+		auto *p = __beg.get();
+		const size_t c = countof(__beg, __end);
+		if(c == 0) return __val;
+		const size_t n = CCY_MAX_THREADS;
+		auto *r				 = new_construct<__parallel_partial<_Ty>[]>(n);
+		try
 		{
-			return this->buf_->__submit_future_task(std::move(__fun), std::forward<_Args>(__args)...);
+			__parallel_run(
+			 c,
+			 __grain,
+			 [&](size_t __b, size_t __e)
+			 {
+				_Ty v(p[__b]);
+				for(size_t i = __b + 1; i != __e; ++i) v = __op(std::move(v), p[i]);
+				auto &k = r[this_thread::get_idx()];	// NOTE: Only this thread touches it
+				if(k.set)
+				{
+					*k.__get() = __op(std::move(*k.__get()), std::move(v));
+				}
+				else
+				{
+					construct(k.__get(), std::move(v));
+					k.set = true;
+				}
+			});
+			for(size_t i = 0; i != n; ++i)
+			{
+				if(r[i].set) __val = __op(std::move(__val), std::move(*r[i].__get()));
+			}
+		} catch(std::exception const &)
+		{
+			destroy_delete<__parallel_partial<_Ty>[]>(r);
+			throw;
 		}
+		destroy_delete<__parallel_partial<_Ty>[]>(r);
+		return __val;
+	}
+	template<
+	 typename _Iterator,
+	 typename _Ty>
+	pf_hint_nodiscard pf_decl_inline _Ty
+	parallel_reduce(
+	 _Iterator __beg,
+	 _Iterator __end,
+	 _Ty __val,
+	 size_t __grain = 0)
+		requires(is_sequence_iterator_v<_Iterator>)
+	{
+		return parallel_reduce(
+		 __beg,
+		 __end,
+		 std::move(__val),
+		 [](_Ty &&__l, auto const &__r)
+		 { return std::move(__l) + __r; },
+		 __grain);
+	}
+	template<
+	 typename _Iterable,
+	 typename _Ty,
+	 typename _BinaryOperation>
+	pf_hint_nodiscard pf_decl_inline _Ty
+	parallel_reduce(
+	 _Iterable &__iterable,
+	 _Ty __val,
+	 _BinaryOperation &&__op,
+	 size_t __grain = 0)
+		requires(is_iterable_v<_Iterable> && is_sequence_iterator_v<typename _Iterable::iterator_t>)
+	{
+		return parallel_reduce(__iterable.begin(), __iterable.end(), std::move(__val), std::forward<_BinaryOperation>(__op), __grain);
+	}
 
-		/// Finished
-		pf_hint_nodiscard bool
-		is_finished() const pf_attr_noexcept
+	/// CONCURRENCY: Parallel -> Transform
+	template<
+	 typename _IteratorIn,
+	 typename _IteratorOut,
+	 typename _UnaryOperation>
+	pf_decl_inline _IteratorOut
+	parallel_transform(
+	 _IteratorIn __ib,
+	 _IteratorIn __ie,
+	 _IteratorOut __ob,
+	 _UnaryOperation &&__op,
+	 size_t __grain = 0)
+		requires(is_sequence_iterator_v<_IteratorIn> && is_sequence_iterator_v<_IteratorOut>)
+	{
+		auto *i				 = __ib.get();
+		auto *o				 = __ob.get();
+		const size_t c = countof(__ib, __ie);
+		__parallel_run(
+		 c,
+		 __grain,
+		 [&](size_t __b, size_t __e)
+		 {
+			for(size_t k = __b; k != __e; ++k) o[k] = __op(i[k]);
+		});
+		__ob += c;
+		return __ob;
+	}
+	template<
+	 typename _IteratorIn,
+	 typename _IteratorOut,
+	 typename _BinaryOperation>
+	pf_decl_inline _IteratorOut
+	parallel_transform(
+	 _IteratorIn __i1b,
+	 _IteratorIn __ie,
+	 _IteratorIn __i2b,
+	 _IteratorOut __ob,
+	 _BinaryOperation &&__op,
+	 size_t __grain = 0)
+		requires(is_sequence_iterator_v<_IteratorIn> && is_sequence_iterator_v<_IteratorOut>)
+	{
+		auto *i1			 = __i1b.get();
+		auto *i2			 = __i2b.get();
+		auto *o				 = __ob.get();
+		const size_t c = countof(__i1b, __ie);
+		__parallel_run(
+		 c,
+		 __grain,
+		 [&](size_t __b, size_t __e)
+		 {
+			for(size_t k = __b; k != __e; ++k) o[k] = __op(i1[k], i2[k]);
+		});
+		__ob += c;
+		return __ob;
+	}
+
+	/// CONCURRENCY: Parallel -> Pipeline
+	enum class pipeline_mode : uint32_t
+	{
+		parallel						= 0,	// Tokens go through concurrently
+		serial_in_order			= 1,	// One token at a time, in the order the source produced them
+		serial_out_of_order = 2		// One token at a time, in any order
+	};
+
+	/*! @brief Passed to the source, stop() ends the stream and discards the value just returned.
+	 */
+	class pipeline_control pf_attr_final
+	{
+	public:
+		/// Stop
+		pf_decl_inline void
+		stop() pf_attr_noexcept
 		{
-			return this->buf_->__is_finished();
+			this->stopped_ = true;
 		}
-
-		/// Wait
-		bool
-		wait() const pf_attr_noexcept
+		pf_hint_nodiscard pf_decl_inline bool
+		is_stopped() const pf_attr_noexcept
 		{
-			return this->buf_->__wait();
+			return this->stopped_;
 		}
 
 	private:
 		/// Store
-		__task_pool_store_t *buf_;
+		bool stopped_ = false;
 	};
 
-	/// CONCURRENCY: Task -> Pool
-	class task_pool_0_t pf_attr_final
+	/*! @brief Stage turning an _InTy into an _OutTy. The first stage is the source, _InTy is void and
+	 *				 its function is called as _OutTy(pipeline_control &), always serially. The last one is the sink, _OutTy is void.
+	 */
+	template<
+	 typename _InTy,
+	 typename _OutTy,
+	 typename _FunTy>
+	struct pipeline_stage pf_attr_final
 	{
-	public:
+		using in_t	= _InTy;
+		using out_t = _OutTy;
+
+		/// Store
+		pipeline_mode mode;
+		_FunTy fun;
+	};
+	template<
+	 typename _InTy,
+	 typename _OutTy,
+	 typename _FunTy>
+	pf_hint_nodiscard pf_decl_inline pipeline_stage<_InTy, _OutTy, std::decay_t<_FunTy>>
+	make_pipeline_stage(
+	 pipeline_mode __mode,
+	 _FunTy &&__fun)
+	{
+		return { __mode, std::forward<_FunTy>(__fun) };
+	}
+
+	template<typename _Ty>
+	struct __pipeline_value
+	{
+		pf_decl_static pf_decl_constexpr size_t size	= sizeof(_Ty);
+		pf_decl_static pf_decl_constexpr size_t align = alignof(_Ty);
+	};
+	template<>
+	struct __pipeline_value<void>
+	{
+		pf_decl_static pf_decl_constexpr size_t size	= 1;
+		pf_decl_static pf_decl_constexpr size_t align = 1;
+	};
+
+	/*! @brief A bounded number of tokens flow through the stages. A token runs parallel stages inline and
+	 *				 parks on the inbox of serial ones, the thread holding a serial stage drains its inbox, forwards
+	 *				 the tokens it processed as new tasks and keeps the last one. Finished tokens go back to the source.
+	 */
+	template<typename... _Stages>
+	struct __pipeline_store pf_attr_final
+	{
+		pf_decl_static pf_decl_constexpr size_t NUM_STAGES	= sizeof...(_Stages);
+		pf_decl_static pf_decl_constexpr size_t VALUE_ALIGN = std::max({ __pipeline_value<typename _Stages::out_t>::align... });
+		pf_decl_static pf_decl_constexpr size_t VALUE_SIZE	= (std::max({ __pipeline_value<typename _Stages::out_t>::size... }) + VALUE_ALIGN - 1) & ~(VALUE_ALIGN - 1);
+
+		/// Type -> Token
+		struct __token_t
+		{
+			__token_t *next;
+			size_t seq;
+			bool dead;	// A stage threw, the following ones are skipped
+			pf_alignas(VALUE_ALIGN) byte_t values[2][VALUE_SIZE];	 // NOTE: Stage k reads values[(k - 1) & 1], writes values[k & 1]
+		};
+
+		/// Type -> Serial
+		struct __serial_t
+		{
+			pf_alignas(CCY_ALIGN) atomic<bool> busy = false;
+			pf_alignas(CCY_ALIGN) atomic<__token_t *> inbox = nullptr;
+			__token_t *pending = nullptr;	// Owned by the busy holder, sorted by seq when in order
+			size_t next				 = 0;
+		};
+
 		/// Constructors
-		task_pool_0_t()
-			: buf_(new_construct<__task_pool_store_t>())
+		template<typename... _InStages>
+		__pipeline_store(
+		 size_t __maxTokens,
+		 _InStages &&...__stages)
+			: numRefs(0)
+			, stopped(false)
+			, failed(false)
+			, maxTokens(std::max<size_t>(__maxTokens, 1))
+			, seq(0)
+			, stages(std::forward<_InStages>(__stages)...)
 		{}
-		task_pool_0_t(task_pool_0_t const &) = delete;
-		task_pool_0_t(task_pool_0_t &&__r)
-			: buf_(__r.buf_)
+		__pipeline_store(__pipeline_store<_Stages...> const &) = delete;
+		__pipeline_store(__pipeline_store<_Stages...> &&)			 = delete;
+
+		/// Destructor
+		~__pipeline_store() pf_attr_noexcept = default;
+
+		/// Operator =
+		__pipeline_store<_Stages...> &
+		operator=(__pipeline_store<_Stages...> const &) = delete;
+		__pipeline_store<_Stages...> &
+		operator=(__pipeline_store<_Stages...> &&) = delete;
+
+		/// Fail
+		void
+		__fail() pf_attr_noexcept
 		{
-			__r.buf_ = nullptr;
+			if(!this->failed.exchange(true, atomic_order::relaxed)) this->exception = std::current_exception();
+			this->stopped.store(true, atomic_order::relaxed);
 		}
 
-		/// Destructor
-		~task_pool_0_t() pf_attr_noexcept
+		/// Apply
+		template<size_t _Index>
+		pf_hint_nodiscard bool
+		__apply(
+		 __token_t *__token) pf_attr_noexcept
 		{
-			this->wait();
-			if(this->buf_) destroy_delete(this->buf_);
+			auto &st	 = i_get<_Index>(this->stages);
+			using in_t	= typename std::remove_reference_t<decltype(st)>::in_t;
+			using out_t = typename std::remove_reference_t<decltype(st)>::out_t;
+			void *o			= &__token->values[_Index & 1][0];
+			if pf_decl_constexpr(_Index == 0)
+			{
+				// Source -> Tokens are retired once it stopped
+				if(this->stopped.load(atomic_order::relaxed)) return false;
+				pipeline_control c;
+				try
+				{
+					new(o) out_t(st.fun(c));
+				} catch(std::exception const &)
+				{
+					this->__fail();
+					return false;
+				}
+				if(c.is_stopped())
+				{
+					destroy(union_cast<out_t *>(o));
+					this->stopped.store(true, atomic_order::relaxed);
+					return false;
+				}
+				__token->seq	= this->seq++;
+				__token->dead = false;
+			}
+			else
+			{
+				in_t *i = union_cast<in_t *>(&__token->values[(_Index - 1) & 1][0]);
+				if(!__token->dead)
+				{
+					try
+					{
+						if pf_decl_constexpr(std::is_void_v<out_t>)
+							st.fun(std::move(*i));
+						else
+							new(o) out_t(st.fun(std::move(*i)));
+					} catch(std::exception const &)
+					{
+						this->__fail();
+						__token->dead = true;
+					}
+					destroy(i);
+				}
+			}
+			return true;
 		}
 
-		/// Operator =
-		task_pool_0_t &
-		operator=(
-		 task_pool_0_t const &) = delete;
-		task_pool_0_t &
-		operator=(
-		 task_pool_0_t &&__r) pf_attr_noexcept
+		/// Serial -> Take
+		pf_hint_nodiscard __token_t *
+		__take(
+		 __serial_t &__s,
+		 bool __inOrder) pf_attr_noexcept
 		{
-			if(pf_likely(this != &__r))
+			__token_t *n = __s.inbox.exchange(nullptr, atomic_order::acquire);
+			if(__inOrder)
 			{
-				if(this->buf_) destroy_delete(this->buf_);
-				this->buf_ = __r.buf_;
-				__r.buf_	 = nullptr;
+				while(n)
+				{
+					__token_t *x	= n->next;
+					__token_t **p = &__s.pending;
+					while(*p && (*p)->seq < n->seq) p = &(*p)->next;
+					n->next = *p;
+					*p			= n;
+					n				= x;
+				}
+				if(!__s.pending || __s.pending->seq != __s.next) return nullptr;
+				++__s.next;
 			}
-			return *this;
+			else
+			{
+				while(n)
+				{
+					__token_t *x = n->next;
+					n->next			 = __s.pending;
+					__s.pending	 = n;
+					n						 = x;
+				}
+				if(!__s.pending) return nullptr;
+			}
+			__token_t *t = __s.pending;
+			__s.pending	 = t->next;
+			return t;
 		}
 
-		/// Submit
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		void
-		submit_task_0(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
+		/// Serial -> Run
+		template<size_t _Index>
+		pf_hint_nodiscard __token_t *
+		__serial(
+		 __token_t *__token,
+		 bool __inOrder) pf_attr_noexcept
 		{
-			this->buf_->__submit_task_0(std::move(__fun), std::forward<_Args>(__args)...);
+			// Park
+			__serial_t &s = this->serial[_Index];
+			__token->next = s.inbox.load(atomic_order::relaxed);
+			while(!s.inbox.compare_exchange_weak(__token->next, __token, atomic_order::seq_cst, atomic_order::relaxed))
+				;
+
+			// Drain -> Whoever holds the stage runs every parked token
+			__token_t *carry = nullptr;
+			while(!s.busy.exchange(true, atomic_order::seq_cst))
+			{
+				while(__token_t *t = this->__take(s, __inOrder))
+				{
+					if(!this->template __apply<_Index>(t))
+					{
+						destroy_delete(t);
+						this->numRefs.fetch_sub(1, atomic_order::relaxed);	// NOTE: Retired, this driver still holds a reference
+						continue;
+					}
+					if(carry) this->__forward(carry, _Index + 1);
+					carry = t;
+				}
+				s.busy.store(false, atomic_order::seq_cst);
+				if(!s.inbox.load(atomic_order::seq_cst)) break;	 // NOTE: Pairs with the park, no token is left behind
+			}
+			return carry;
 		}
 
-		/// Submit Future
-		template<
-		 typename _FunTy,
-		 typename... _Args>
-		pf_hint_nodiscard future<std::invoke_result_t<_FunTy, _Args...>>
-		submit_future_task_0(
-		 _FunTy &&__fun,
-		 _Args &&...__args) pf_attr_noexcept
-			requires(std::is_invocable_v<_FunTy, _Args...>)
+		/// Step
+		template<size_t _Index = 0>
+		pf_hint_nodiscard __token_t *
+		__step(
+		 size_t __k,
+		 __token_t *__token) pf_attr_noexcept
 		{
-			return this->buf_->__submit_future_task_0(std::move(__fun), std::forward<_Args>(__args)...);
+			if pf_decl_constexpr(_Index + 1 < NUM_STAGES)
+			{
+				if(__k != _Index) return this->template __step<_Index + 1>(__k, __token);
+			}
+			if pf_decl_constexpr(_Index == 0)
+			{
+				return this->template __serial<0>(__token, false);
+			}
+			else
+			{
+				const pipeline_mode m = i_get<_Index>(this->stages).mode;
+				if(m == pipeline_mode::parallel)
+				{
+					(void)this->template __apply<_Index>(__token);
+					return __token;
+				}
+				return this->template __serial<_Index>(__token, m == pipeline_mode::serial_in_order);
+			}
 		}
 
-		/// Finished
-		pf_hint_nodiscard bool
-		is_finished() const pf_attr_noexcept
+		/// Drive
+		void
+		__drive(
+		 __token_t *__token,
+		 size_t __k) pf_attr_noexcept
 		{
-			return this->buf_->__is_finished();
+			this->numRefs.fetch_add(1, atomic_order::relaxed);
+			while(__token)
+			{
+				__token = this->__step(__k, __token);
+				__k			= __k + 1 == NUM_STAGES ? 0 : __k + 1;
+			}
+			this->numRefs.fetch_sub(1, atomic_order::release);
+		}
+		void
+		__forward(
+		 __token_t *__token,
+		 size_t __k) pf_attr_noexcept
+		{
+			this->numRefs.fetch_add(1, atomic_order::relaxed);	// NOTE: Held by the task until its driver starts
+			__submit_task_always(
+			 [this, __token, __k]()
+			 {
+				 this->__drive(__token, __k == NUM_STAGES ? 0 : __k);
+				 this->numRefs.fetch_sub(1, atomic_order::release);
+			 });
 		}
 
-		/// Wait
-		bool
-		wait() const pf_attr_noexcept
+		/// Run
+		void
+		__run()
 		{
-			return this->buf_->__wait();
+			// Tokens -> Idle on the source inbox, the caller drives the first one
+			this->numRefs.store(this->maxTokens, atomic_order::relaxed);
+			__token_t *f = nullptr;
+			for(size_t i = 0; i != this->maxTokens; ++i)
+			{
+				__token_t *t = new_construct<__token_t>();
+				if(f)
+				{
+					t->next = this->serial[0].inbox.load(atomic_order::relaxed);
+					this->serial[0].inbox.store(t, atomic_order::relaxed);
+				}
+				else
+				{
+					f = t;
+				}
+			}
+			this->__drive(f, 0);
+
+			// Wait
+			// NOTE: Never left early, workers still use this store until the last reference is gone
+			while(this->numRefs.load(atomic_order::acquire) != 0)
+			{
+				if(!__task_help()) this_thread::yield();
+			}
+			if(this->failed.load(atomic_order::relaxed)) std::rethrow_exception(this->exception);
 		}
 
-	private:
 		/// Store
-		__task_pool_store_t *buf_;
+		pf_alignas(CCY_ALIGN) atomic<size_t> numRefs;	// Live tokens plus running drivers
+		atomic<bool> stopped;
+		atomic<bool> failed;
+		std::exception_ptr exception;
+		const size_t maxTokens;
+		size_t seq;	 // Owned by the source holder
+		__serial_t serial[NUM_STAGES];
+		tuple<_Stages...> stages;
 	};
+
+	/// CONCURRENCY: Parallel -> Pipeline -> Stages
+	template<size_t _Index, typename... _Stages>
+	using __pipeline_stage_t = std::remove_cvref_t<decltype(i_get<_Index>(std::declval<tuple<_Stages...> &>()))>;
+	template<typename... _Stages, size_t... _Is>
+	pf_hint_nodiscard pf_decl_consteval bool
+	__pipeline_stages_chain(
+	 index_sequence<_Is...>) pf_attr_noexcept
+	{
+		return (std::is_same_v<typename __pipeline_stage_t<_Is + 1, _Stages...>::in_t, typename __pipeline_stage_t<_Is, _Stages...>::out_t> && ...);
+	}
+
+	/*! @brief Runs the stages over the stream the source produces, with at most __maxTokens items in flight,
+	 *				 and returns once it is drained. The caller takes part, the first exception a stage threw is rethrown.
+	 */
+	template<typename... _Stages>
+	pf_decl_inline void
+	parallel_pipeline(
+	 size_t __maxTokens,
+	 _Stages &&...__stages)
+		requires(sizeof...(_Stages) >= 2)
+	{
+		using store_t = __pipeline_store<std::decay_t<_Stages>...>;
+		pf_assert_static(std::is_void_v<typename __pipeline_stage_t<0, std::decay_t<_Stages>...>::in_t>, "The first stage is the source, its _InTy must be void!");
+		pf_assert_static(std::is_void_v<typename __pipeline_stage_t<sizeof...(_Stages) - 1, std::decay_t<_Stages>...>::out_t>, "The last stage is the sink, its _OutTy must be void!");
+		pf_assert_static(__pipeline_stages_chain<std::decay_t<_Stages>...>(make_index_sequence<sizeof...(_Stages) - 1>{}), "Each stage's _InTy must be the previous stage's _OutTy!");
+		store_t s(__maxTokens, std::forward<_Stages>(__stages)...);
+		s.__run();
+	}
 }	 // namespace pul
 
 #endif	// !PULSAR_THREAD_POOL_HPP
@@ -0,0 +1,349 @@
+/*! @file   reclamation.cpp
+ *  @author Louis-Quentin Noé (noe.louis-quentin@hotmail.fr)
+ *  @brief
+ *  @date   17-10-2026
+ *
+ *  @copyright Copyright (c) 2023 - Pulsar Software
+ *
+ *  @since 0.1.6
+ */
+
+// Include: Pulsar
+#include "pulsar/internal.hpp"
+
+// Include: C++
+#include <algorithm>
+
+// Pulsar
+namespace pul
+{
+	/// RECLAMATION: Local
+	struct __reclaim_local_t
+	{
+		/// Constructors
+		__reclaim_local_t() pf_attr_noexcept
+			: hazard(nullptr)
+			, epoch(nullptr)
+		{}
+		__reclaim_local_t(__reclaim_local_t const &) = delete;
+		__reclaim_local_t(__reclaim_local_t &&)			 = delete;
+
+		/// Destructor
+		~__reclaim_local_t() pf_attr_noexcept
+		{
+			if(this->hazard) __internal.reclaim.__hazard_release(this->hazard, this->hazardRetired);
+			if(this->epoch) __internal.reclaim.__epoch_release(this->epoch, this->epochRetired);
+			this->hazard = nullptr;	 // NOTE: Statics destroyed after this thread's locals take a new record, leaked
+			this->epoch	 = nullptr;
+		}
+
+		/// Operator =
+		__reclaim_local_t &
+		operator=(__reclaim_local_t const &) = delete;
+		__reclaim_local_t &
+		operator=(__reclaim_local_t &&) = delete;
+
+		/// Store
+		__hazard_record_t *hazard;
+		__epoch_record_t *epoch;
+		sequence<__retired_t> hazardRetired;
+		sequence<__retired_t> epochRetired;
+	};
+	pf_decl_static pf_decl_thread_local __reclaim_local_t __this_reclaim;
+
+	/// RECLAMATION: Free
+	pf_hint_nodiscard pf_decl_static size_t
+	__reclaim_free_if(
+	 sequence<__retired_t> &__retired,
+	 auto &&__canFree)
+	{
+		// Survivors are compacted to the front, expired ones moved out
+		sequence<__retired_t> expired;
+		size_t k = 0;
+		const size_t n = __retired.count();
+		for(size_t i = 0; i != n; ++i)
+		{
+			__retired_t r = __retired[i];
+			if(__canFree(r))
+				expired.insert_back(r);
+			else
+				__retired[k++] = r;
+		}
+		if(k != n) __retired.remove(__retired.begin() + k, __retired.end());
+
+		// Free, a deleter may retire again into __retired
+		for(auto &r: expired) r.fun(r.ptr);
+		return expired.count();
+	}
+
+	/// RECLAMATION: Domain
+	// Constructors
+	__reclaim_domain_t::__reclaim_domain_t() pf_attr_noexcept
+		: epoch(0)
+		, hazardRecords_(nullptr)
+		, numHazardRecords_(0)
+		, epochRecords_(nullptr)
+		, hasHazardOrphans_(false)
+		, hasEpochOrphans_(false)
+	{}
+
+	// Destructor
+	__reclaim_domain_t::~__reclaim_domain_t() pf_attr_noexcept
+	{
+		// Orphans -> No thread is left to reach them
+		for(auto &r: this->hazardOrphans_) r.fun(r.ptr);
+		for(auto &r: this->epochOrphans_) r.fun(r.ptr);
+
+		// NOTE: Records are leaked, threads that aren't joined yet may still hold theirs
+	}
+
+	// Orphans
+	void
+	__reclaim_domain_t::__adopt(
+	 sequence<__retired_t> &__orphans,
+	 atomic<bool> &__hasOrphans,
+	 sequence<__retired_t> &__retired)
+	{
+		if(!__hasOrphans.load(atomic_order::relaxed)) return;
+		lock_unique<mutex_t> lck(this->mutex_);
+		for(auto &r: __orphans) __retired.insert_back(r);
+		__orphans.clear();
+		__hasOrphans.store(false, atomic_order::relaxed);
+	}
+
+	// Hazard
+	__hazard_record_t *
+	__reclaim_domain_t::__hazard_acquire()
+	{
+		// Reuse -> Released by an exited thread
+		for(__hazard_record_t *r = this->hazardRecords_.load(atomic_order::acquire); r; r = r->next)
+		{
+			bool e = false;
+			if(!r->active.load(atomic_order::relaxed) && r->active.compare_exchange_strong(e, true, atomic_order::acquire, atomic_order::relaxed)) return r;
+		}
+
+		// New
+		__hazard_record_t *r = new_construct<__hazard_record_t>();
+		for(uint32_t i = 0; i != CCY_HAZARD_NUM_SLOTS; ++i) r->slots[i].store(nullptr, atomic_order::relaxed);
+		r->active.store(true, atomic_order::relaxed);
+		r->used = 0;
+		r->next = this->hazardRecords_.load(atomic_order::relaxed);
+		while(!this->hazardRecords_.compare_exchange_weak(r->next, r, atomic_order::release, atomic_order::relaxed))
+			;
+		this->numHazardRecords_.fetch_add(1, atomic_order::relaxed);
+		return r;
+	}
+	void
+	__reclaim_domain_t::__hazard_release(
+	 __hazard_record_t *__record,
+	 sequence<__retired_t> &__retired) pf_attr_noexcept
+	{
+		for(uint32_t i = 0; i != CCY_HAZARD_NUM_SLOTS; ++i) __record->slots[i].store(nullptr, atomic_order::release);
+		__record->used = 0;
+		__record->active.store(false, atomic_order::release);
+		try
+		{
+			this->__hazard_scan(__retired);
+			if(__retired.count() == 0) return;
+			lock_unique<mutex_t> lck(this->mutex_);
+			for(auto &r: __retired) this->hazardOrphans_.insert_back(r);
+			this->hasHazardOrphans_.store(true, atomic_order::relaxed);
+		} catch(std::exception const &)
+		{
+			// NOTE: Out of memory, what's left leaks rather than being freed while protected
+		}
+		__retired.clear();
+	}
+	void
+	__reclaim_domain_t::__hazard_scan(
+	 sequence<__retired_t> &__retired)
+	{
+		this->__adopt(this->hazardOrphans_, this->hasHazardOrphans_, __retired);
+
+		// Protected -> Sorted snapshot of every slot
+		std::atomic_thread_fence(atomic_order::seq_cst);	// NOTE: Pairs with protect, the objects are unlinked already
+		sequence<void *> p;
+		for(__hazard_record_t *r = this->hazardRecords_.load(atomic_order::acquire); r; r = r->next)
+		{
+			for(uint32_t i = 0; i != CCY_HAZARD_NUM_SLOTS; ++i)
+			{
+				void *v = r->slots[i].load(atomic_order::seq_cst);
+				if(v) p.insert_back(v);
+			}
+		}
+		std::sort(p.begin(), p.end());
+
+		// Free
+		ignore = __reclaim_free_if(
+		 __retired,
+		 [&p](__retired_t const &__r)
+		 { return !std::binary_search(p.begin(), p.end(), __r.ptr); });
+	}
+	size_t
+	__reclaim_domain_t::__hazard_threshold() const pf_attr_noexcept
+	{
+		return std::max(CCY_RECLAIM_THRESHOLD, 2 * CCY_HAZARD_NUM_SLOTS * this->numHazardRecords_.load(atomic_order::relaxed));	 // NOTE: Amortizes the scan
+	}
+
+	// Epoch
+	__epoch_record_t *
+	__reclaim_domain_t::__epoch_acquire()
+	{
+		// Reuse
+		for(__epoch_record_t *r = this->epochRecords_.load(atomic_order::acquire); r; r = r->next)
+		{
+			bool e = false;
+			if(!r->active.load(atomic_order::relaxed) && r->active.compare_exchange_strong(e, true, atomic_order::acquire, atomic_order::relaxed)) return r;
+		}
+
+		// New
+		__epoch_record_t *r = new_construct<__epoch_record_t>();
+		r->epoch.store(0, atomic_order::relaxed);
+		r->active.store(true, atomic_order::relaxed);
+		r->nesting = 0;
+		r->next		 = this->epochRecords_.load(atomic_order::relaxed);
+		while(!this->epochRecords_.compare_exchange_weak(r->next, r, atomic_order::release, atomic_order::relaxed))
+			;
+		return r;
+	}
+	void
+	__reclaim_domain_t::__epoch_release(
+	 __epoch_record_t *__record,
+	 sequence<__retired_t> &__retired) pf_attr_noexcept
+	{
+		__record->epoch.store(0, atomic_order::release);
+		__record->nesting = 0;
+		__record->active.store(false, atomic_order::release);
+		try
+		{
+			this->__epoch_scan(__retired);
+			if(__retired.count() == 0) return;
+			lock_unique<mutex_t> lck(this->mutex_);
+			for(auto &r: __retired) this->epochOrphans_.insert_back(r);
+			this->hasEpochOrphans_.store(true, atomic_order::relaxed);
+		} catch(std::exception const &)
+		{
+			// NOTE: Out of memory, what's left leaks
+		}
+		__retired.clear();
+	}
+	bool
+	__reclaim_domain_t::__epoch_try_advance() pf_attr_noexcept
+	{
+		// Every pinned thread must have seen the current epoch
+		uint64_t e = this->epoch.load(atomic_order::seq_cst);
+		for(__epoch_record_t *r = this->epochRecords_.load(atomic_order::acquire); r; r = r->next)
+		{
+			const uint64_t l = r->epoch.load(atomic_order::seq_cst);
+			if((l & 1) && (l >> 1) != e) return false;
+		}
+		return this->epoch.compare_exchange_strong(e, e + 1, atomic_order::seq_cst, atomic_order::relaxed);
+	}
+	void
+	__reclaim_domain_t::__epoch_synchronize() pf_attr_noexcept
+	{
+		const uint64_t e = this->epoch.load(atomic_order::seq_cst);
+		while(this->epoch.load(atomic_order::acquire) < e + 2)	// NOTE: Threads pinned at e or before have all left
+		{
+			if(!this->__epoch_try_advance()) this_thread::yield();
+		}
+	}
+	void
+	__reclaim_domain_t::__epoch_scan(
+	 sequence<__retired_t> &__retired)
+	{
+		this->__adopt(this->epochOrphans_, this->hasEpochOrphans_, __retired);
+		this->__epoch_try_advance();
+		const uint64_t g = this->epoch.load(atomic_order::acquire);
+		ignore					 = __reclaim_free_if(
+			 __retired,
+			 [g](__retired_t const &__r)
+			 { return __r.epoch + 2 <= g; });	 // NOTE: Threads pinned when it was retired have all left
+	}
+
+	/// CONCURRENCY: Reclamation -> Hazard Pointers
+	pulsar_api __hazard_record_t *
+	__hazard_this_record()
+	{
+		if(!__this_reclaim.hazard) __this_reclaim.hazard = __internal.reclaim.__hazard_acquire();
+		return __this_reclaim.hazard;
+	}
+	pulsar_api atomic<void *> *
+	__hazard_acquire_slot()
+	{
+		__hazard_record_t *r = __hazard_this_record();
+		uint32_t i					 = 0;
+		while(i != CCY_HAZARD_NUM_SLOTS && (r->used & (1u << i))) ++i;
+		pf_throw_if(
+		 i == CCY_HAZARD_NUM_SLOTS,
+		 dbg_category_generic(),
+		 dbg_code::runtime_error,
+		 dbg_flags::none,
+		 "All {} hazard pointer slots of this thread are in use!",
+		 CCY_HAZARD_NUM_SLOTS);
+		r->used |= 1u << i;
+		return &r->slots[i];
+	}
+	pulsar_api void
+	__hazard_retire(
+	 void *__ptr,
+	 __reclaim_fun_t __fun)
+	{
+		ignore = __hazard_this_record();	// NOTE: Its release at exit flushes the list
+		__this_reclaim.hazardRetired.insert_back(__retired_t { __ptr, __fun, 0 });
+		if(__this_reclaim.hazardRetired.count() >= __internal.reclaim.__hazard_threshold()) __internal.reclaim.__hazard_scan(__this_reclaim.hazardRetired);
+	}
+	pulsar_api void
+	hazard_reclaim()
+	{
+		__internal.reclaim.__hazard_scan(__this_reclaim.hazardRetired);
+	}
+	pulsar_api size_t
+	hazard_num_retired() pf_attr_noexcept
+	{
+		return __this_reclaim.hazardRetired.count();
+	}
+
+	/// CONCURRENCY: Reclamation -> Epochs
+	pulsar_api __epoch_record_t *
+	__epoch_this_record()
+	{
+		if(!__this_reclaim.epoch) __this_reclaim.epoch = __internal.reclaim.__epoch_acquire();
+		return __this_reclaim.epoch;
+	}
+	pulsar_api atomic<uint64_t> &
+	__epoch_global() pf_attr_noexcept
+	{
+		return __internal.reclaim.epoch;
+	}
+	pulsar_api void
+	__epoch_retire(
+	 void *__ptr,
+	 __reclaim_fun_t __fun)
+	{
+		ignore = __epoch_this_record();
+		__this_reclaim.epochRetired.insert_back(__retired_t { __ptr, __fun, __internal.reclaim.epoch.load(atomic_order::seq_cst) });
+		if(__this_reclaim.epochRetired.count() >= CCY_RECLAIM_THRESHOLD) __internal.reclaim.__epoch_scan(__this_reclaim.epochRetired);
+	}
+	pulsar_api void
+	epoch_reclaim()
+	{
+		__internal.reclaim.__epoch_scan(__this_reclaim.epochRetired);
+	}
+	pulsar_api void
+	epoch_synchronize()
+	{
+		pf_throw_if(
+		 __epoch_this_record()->nesting != 0,
+		 dbg_category_generic(),
+		 dbg_code::runtime_error,
+		 dbg_flags::none,
+		 "epoch_synchronize called inside an epoch_guard, it would wait for itself!");
+		__internal.reclaim.__epoch_synchronize();
+	}
+	pulsar_api size_t
+	epoch_num_retired() pf_attr_noexcept
+	{
+		return __this_reclaim.epochRetired.count();
+	}
+}	 // namespace pul
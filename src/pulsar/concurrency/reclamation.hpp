@@ -0,0 +1,107 @@
+/*! @file   reclamation.hpp
+ *  @author Louis-Quentin Noé (noe.louis-quentin@hotmail.fr)
+ *  @brief
+ *  @date   17-10-2026
+ *
+ *  @copyright Copyright (c) 2023 - Pulsar Software
+ *
+ *  @since 0.1.6
+ */
+
+#ifndef PULSAR_SRC_RECLAMATION_HPP
+#define PULSAR_SRC_RECLAMATION_HPP 1
+
+// Include: Pulsar
+#include "pulsar/pulsar.hpp"
+#include "pulsar/concurrency.hpp"
+#include "pulsar/iterable.hpp"
+
+// Pulsar
+namespace pul
+{
+	/// RECLAMATION: Constants
+	pf_decl_constexpr size_t CCY_RECLAIM_THRESHOLD = 64;	// Retired objects a thread keeps before scanning
+
+	/// RECLAMATION: Retired
+	struct __retired_t
+	{
+		void *ptr;
+		__reclaim_fun_t fun;
+		uint64_t epoch;	 // Global epoch when retired, unused by hazard pointers
+	};
+
+	/// RECLAMATION: Domain
+	/*! @brief Registries of the per-thread hazard and epoch records. Records are never freed, a thread
+	 *				 exiting releases its own for the next one and hands the objects it couldn't free yet to the orphan lists.
+	 */
+	class __reclaim_domain_t
+	{
+	public:
+		/// Constructors
+		__reclaim_domain_t() pf_attr_noexcept;
+		__reclaim_domain_t(__reclaim_domain_t const &) = delete;
+		__reclaim_domain_t(__reclaim_domain_t &&)			 = delete;
+
+		/// Destructor
+		~__reclaim_domain_t() pf_attr_noexcept;
+
+		/// Operator =
+		__reclaim_domain_t &
+		operator=(
+		 __reclaim_domain_t const &) = delete;
+		__reclaim_domain_t &
+		operator=(
+		 __reclaim_domain_t &&) = delete;
+
+		/// Hazard
+		pf_hint_nodiscard __hazard_record_t *
+		__hazard_acquire();
+		void
+		__hazard_release(
+		 __hazard_record_t *__record,
+		 sequence<__retired_t> &__retired) pf_attr_noexcept;
+		void
+		__hazard_scan(
+		 sequence<__retired_t> &__retired);
+		pf_hint_nodiscard size_t
+		__hazard_threshold() const pf_attr_noexcept;
+
+		/// Epoch
+		pf_hint_nodiscard __epoch_record_t *
+		__epoch_acquire();
+		void
+		__epoch_release(
+		 __epoch_record_t *__record,
+		 sequence<__retired_t> &__retired) pf_attr_noexcept;
+		void
+		__epoch_scan(
+		 sequence<__retired_t> &__retired);
+		bool
+		__epoch_try_advance() pf_attr_noexcept;
+		void
+		__epoch_synchronize() pf_attr_noexcept;
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<uint64_t> epoch;
+
+	private:
+		/// Orphans
+		void
+		__adopt(
+		 sequence<__retired_t> &__orphans,
+		 atomic<bool> &__hasOrphans,
+		 sequence<__retired_t> &__retired);
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<__hazard_record_t *> hazardRecords_;
+		atomic<size_t> numHazardRecords_;
+		pf_alignas(CCY_ALIGN) atomic<__epoch_record_t *> epochRecords_;
+		pf_alignas(CCY_ALIGN) atomic<bool> hasHazardOrphans_;
+		atomic<bool> hasEpochOrphans_;
+		mutex_t mutex_;
+		sequence<__retired_t> hazardOrphans_;
+		sequence<__retired_t> epochOrphans_;
+	};
+}	 // namespace pul
+
+#endif	// !PULSAR_SRC_RECLAMATION_HPP
@@ -14,36 +14,441 @@
 // Pulsar
 namespace pul
 {
+	/// CONCURRENCY: Task -> Slab
+	/// Cache -> Current
+	struct __task_slab_owner_t
+	{
+		/// Destructor
+		~__task_slab_owner_t() pf_attr_noexcept
+		{
+			if(!this->cache) return;
+			__task_slab_cache_t *c = this->cache;
+			this->cache						 = nullptr;	// NOTE: Frees later on this thread go to the remote lists
+			this->slab->__orphan(c);				// NOTE: Thread exit, the chunks stay live for the next thread
+		}
+
+		/// Store
+		__task_slab_t *slab;
+		__task_slab_cache_t *cache;
+	};
+	pf_decl_static pf_decl_thread_local __task_slab_owner_t __this_slab_cache = { nullptr, nullptr };
+
+	/// Cache
+	__task_slab_cache_t::__task_slab_cache_t() pf_attr_noexcept
+		: next(nullptr)
+		, nextOrphan(nullptr)
+	{
+		for(uint32_t i = 0; i != CCY_TASK_SLAB_NUM_BINS; ++i)
+		{
+			this->bins[i].remote.store(nullptr, atomic_order::relaxed);
+			this->bins[i].local	 = nullptr;
+			this->bins[i].chunks = nullptr;
+		}
+	}
+	__task_slab_cache_t::~__task_slab_cache_t() pf_attr_noexcept
+	{
+		for(uint32_t i = 0; i != CCY_TASK_SLAB_NUM_BINS; ++i)
+		{
+			__task_slab_chunk_t *c = this->bins[i].chunks;
+			while(c)
+			{
+				__task_slab_chunk_t *n = c->next;
+				hfree(c);
+				c = n;
+			}
+		}
+	}
+
+	/// Cache -> Allocate
+	void *
+	__task_slab_cache_t::__allocate(
+	 uint32_t __bin,
+	 atomic<size_t> &__numAllocations)
+	{
+		__task_slab_bin_t &b = this->bins[__bin];
+
+		// Remote
+		if(!b.local) b.local = b.remote.exchange(nullptr, atomic_order::acquire);
+
+		// Chunk
+		if(!b.local)
+		{
+			const size_t s = CCY_TASK_SLAB_MIN_SIZE << __bin;
+			auto *c				 = union_cast<__task_slab_chunk_t *>(halloc(CCY_TASK_SLAB_CHUNK_SIZE, align_val_t(CCY_TASK_SLAB_CHUNK_SIZE)));
+			c->owner			 = this;
+			c->next				 = b.chunks;
+			c->bin				 = __bin;
+			b.chunks			 = c;
+			byte_t *p			 = union_cast<byte_t *>(c) + sizeof(__task_slab_chunk_t);
+			byte_t *e			 = union_cast<byte_t *>(c) + CCY_TASK_SLAB_CHUNK_SIZE;
+			for(; p + s <= e; p += s)
+			{
+				auto *k = union_cast<__task_slab_block_t *>(p);
+				k->next = b.local;
+				b.local = k;
+			}
+			__numAllocations.fetch_add(1, atomic_order::relaxed);
+		}
+
+		// Pop
+		__task_slab_block_t *k = b.local;
+		b.local								 = k->next;
+		return k;
+	}
+
+	/// Slab
+	__task_slab_t::__task_slab_t() pf_attr_noexcept
+		: caches_(nullptr)
+		, numAllocations_(0)
+		, orphans_(nullptr)
+	{}
+	__task_slab_t::~__task_slab_t() pf_attr_noexcept
+	{
+		__task_slab_cache_t *c = this->caches_.load(atomic_order::acquire);
+		while(c)
+		{
+			__task_slab_cache_t *n = c->next;
+			destroy_delete(c);
+			c = n;
+		}
+	}
+
+	/// Slab -> Cache
+	__task_slab_cache_t *
+	__task_slab_t::__get_cache()
+	{
+		if(pf_likely(__this_slab_cache.cache)) return __this_slab_cache.cache;
+
+		// Adopt
+		__task_slab_cache_t *c = nullptr;
+		{
+			lock_unique<mutex_t> lck(this->mutex_);
+			c = this->orphans_;
+			if(c) this->orphans_ = c->nextOrphan;
+		}
+
+		// New
+		if(!c)
+		{
+			c				= new_construct<__task_slab_cache_t>();
+			c->next = this->caches_.load(atomic_order::relaxed);
+			while(!this->caches_.compare_exchange_weak(c->next, c, atomic_order::release, atomic_order::relaxed))
+				;
+		}
+		__this_slab_cache.slab	= this;
+		__this_slab_cache.cache = c;
+		return c;
+	}
+	void
+	__task_slab_t::__orphan(
+	 __task_slab_cache_t *__cache) pf_attr_noexcept
+	{
+		lock_unique<mutex_t> lck(this->mutex_);
+		__cache->nextOrphan = this->orphans_;
+		this->orphans_			= __cache;
+	}
+
+	/// Slab -> Allocate
+	void *
+	__task_slab_t::__allocate(
+	 size_t __size,
+	 size_t __align)
+	{
+		// Fallback
+		if(!__task_slab_fits(__size, __align))
+		{
+			this->numAllocations_.fetch_add(1, atomic_order::relaxed);
+			return calloc(__size, align_val_t(__align));
+		}
+
+		// Bin
+		uint32_t i = 0;
+		while((CCY_TASK_SLAB_MIN_SIZE << i) < __size) ++i;
+		return this->__get_cache()->__allocate(i, this->numAllocations_);
+	}
+	void
+	__task_slab_t::__deallocate(
+	 void *__ptr) pf_attr_noexcept
+	{
+		auto *c							 = union_cast<__task_slab_chunk_t *>(union_cast<size_t>(__ptr) & ~(CCY_TASK_SLAB_CHUNK_SIZE - 1));
+		auto *k							 = union_cast<__task_slab_block_t *>(__ptr);
+		__task_slab_bin_t &b = c->owner->bins[c->bin];
+
+		// Local
+		if(c->owner == __this_slab_cache.cache)
+		{
+			k->next = b.local;
+			b.local = k;
+			return;
+		}
+
+		// Remote
+		k->next = b.remote.load(atomic_order::relaxed);
+		while(!b.remote.compare_exchange_weak(k->next, k, atomic_order::release, atomic_order::relaxed))
+			;
+	}
+
+	/// Slab -> Allocations
+	size_t
+	__task_slab_t::__num_allocations() const pf_attr_noexcept
+	{
+		return this->numAllocations_.load(atomic_order::relaxed);
+	}
+
 	/// CONCURRENCY: Thread Pool
+	/// Worker -> Current
+	pf_decl_static pf_decl_thread_local __thread_worker_t *__this_worker = nullptr;
+
+	/// Worker -> Help Depth
+	pf_decl_static pf_decl_thread_local uint32_t __help_depth = 0;
+
+	/// Worker
+	__thread_worker_t::__thread_worker_t(
+	 __thread_pool_storage_t *__owner,
+	 uint32_t __index) pf_attr_noexcept
+		: deque(CCY_TASKS_MAX_NUM_W)
+		, owner(__owner)
+		, index(__index)
+		, seed(__index * 2'654'435'761u + 1)
+		, aging(0)
+	{}
+
+	/// Worker -> Stats
+	thread_pool_stats_t
+	__thread_worker_stats_t::__snapshot() const pf_attr_noexcept
+	{
+		thread_pool_stats_t s;
+		s.numExecuted			= this->numExecuted.load(atomic_order::relaxed);
+		s.numExceptions		= this->numExceptions.load(atomic_order::relaxed);
+		s.numLocal				= this->numLocal.load(atomic_order::relaxed);
+		s.numShared				= this->numShared.load(atomic_order::relaxed);
+		s.numStolen				= this->numStolen.load(atomic_order::relaxed);
+		s.numMisses				= this->numMisses.load(atomic_order::relaxed);
+		s.busyTime				= this->busyTime.load(atomic_order::relaxed);
+		s.idleTime				= this->idleTime.load(atomic_order::relaxed);
+		s.depthSum				= this->depthSum.load(atomic_order::relaxed);
+		s.numDepthSamples = this->numDepthSamples.load(atomic_order::relaxed);
+		s.depthMax				= this->depthMax.load(atomic_order::relaxed);
+		return s;
+	}
+
+	/// Worker -> Victim
+	uint32_t
+	__thread_worker_t::__next_victim() pf_attr_noexcept
+	{
+		// Xorshift32
+		uint32_t x = this->seed;
+		x				 ^= x << 13;
+		x				 ^= x >> 17;
+		x				 ^= x << 5;
+		this->seed = x;
+		return x % this->owner->numWorkers;
+	}
+
 	/// Buffer
-	__thread_pool_storage_t::__thread_pool_storage_t() pf_attr_noexcept
-		: run(true)
+	__thread_pool_storage_t::__thread_pool_storage_t(
+	 __thread_pool_t *__pool,
+	 uint32_t __numWorkers,
+	 size_t __capacity) pf_attr_noexcept
+		: pool(__pool)
+		, numWorkers(__numWorkers)
+		, capacity(__capacity)
+		, run(true)
 		, numTasks(0)
 		, numProcessing(0)
-		, queue(CCY_TASKS_MAX_NUM)
-		, queue0(CCY_TASKS_MAX_NUM_0)
+		, numSleeping(0)
+		, numTasks0(0)
+		, epoch(0)
+		, spinBudget(CCY_SPIN_BUDGET)
+		, queueC(__capacity)
+		, queue(__capacity)
+		, queueB(__capacity)
+		, queue0(__capacity)
 	{}
 
 	/// Thread
-	__thread_t *
-	__thread_pool_storage_t::__get_thread(
+	__thread_worker_t *
+	__thread_pool_storage_t::__get_worker(
 	 uint32_t __index) pf_attr_noexcept
 	{
 		union
 		{
 			byte_t *as_byte;
-			__thread_t *as_thread;
+			__thread_worker_t *as_worker;
 		};
 		as_byte = &this->store[0];
-		return as_thread + __index;
+		return as_worker + __index;
+	}
+	__thread_t *
+	__thread_pool_storage_t::__get_thread(
+	 uint32_t __index) pf_attr_noexcept
+	{
+		return &this->__get_worker(__index)->thread;
+	}
+
+	/// Steal
+	__task_t *
+	__thread_pool_storage_t::__try_steal(
+	 uint32_t __first) pf_attr_noexcept
+	{
+		for(uint32_t i = 0; i != this->numWorkers; ++i)
+		{
+			__task_t *t = this->__get_worker((__first + i) % this->numWorkers)->deque.try_steal();
+			if(t) return t;
+		}
+		return nullptr;
+	}
+
+	/// Dequeue
+	__task_t *
+	__thread_pool_storage_t::__try_dequeue(
+	 __thread_worker_t *__w) pf_attr_noexcept
+	{
+		// No Worker
+		if(!__w)
+		{
+			__task_t *t = this->queueC.try_dequeue();
+			if(!t) t = this->queue.try_dequeue();
+			if(!t) t = this->__try_steal(this_thread::get_idx());
+			if(!t) t = this->queueB.try_dequeue();
+			return t;
+		}
+
+		// Critical
+		__task_t *t = this->queueC.try_dequeue();
+		if(t)
+		{
+			__thread_worker_stats_t::__add(__w->stats.numShared, 1);
+			return t;
+		}
+
+		// Aging
+		if(++__w->aging == CCY_AGING_PERIOD)
+		{
+			__w->aging = 0;
+			t					 = this->queueB.try_dequeue();
+			if(t)
+			{
+				__thread_worker_stats_t::__add(__w->stats.numShared, 1);
+				return t;
+			}
+		}
+
+		// Local
+		t = __w->deque.try_pop();
+		if(t)
+		{
+			__thread_worker_stats_t::__add(__w->stats.numLocal, 1);
+			return t;
+		}
+
+		// Shared
+		t = this->queue.try_dequeue();
+		if(t)
+		{
+			__thread_worker_stats_t::__add(__w->stats.numShared, 1);
+			return t;
+		}
+
+		// Steal
+		t = this->__try_steal(__w->__next_victim());
+		if(t)
+		{
+			__thread_worker_stats_t::__add(__w->stats.numStolen, 1);
+			return t;
+		}
+
+		// Background
+		t = this->queueB.try_dequeue();
+		__thread_worker_stats_t::__add(t ? __w->stats.numShared : __w->stats.numMisses, 1);
+		return t;
+	}
+
+	/// Help
+	pf_decl_static void
+	__thread_help_run(
+	 __task_t *__task,
+	 __thread_worker_t *__w) pf_attr_noexcept
+	{
+		++__help_depth;
+		try
+		{
+			__task->__run();
+		} catch(std::exception const &)
+		{
+			__dbg_move_exception_record_to_0();
+			if(__w) __thread_worker_stats_t::__add(__w->stats.numExceptions, 1);
+		}
+		--__help_depth;
+		if(__w) __thread_worker_stats_t::__add(__w->stats.numExecuted, 1);
+	}
+	bool
+	__thread_pool_storage_t::__help(
+	 __thread_worker_t *__w) pf_attr_noexcept
+	{
+		if(__help_depth == CCY_HELP_MAX_DEPTH) return false;
+		__task_t *t = this->__try_dequeue(__w);
+		if(!t) return false;
+		this->numTasks.fetch_sub(1, atomic_order::relaxed);
+		__thread_help_run(t, __w);
+		return true;
+	}
+
+	/// Parking
+	void
+	__thread_pool_storage_t::__park() pf_attr_noexcept
+	{
+		// Prepare
+		const uint32_t e = this->epoch.load(atomic_order::acquire);
+		this->numSleeping.fetch_add(1, atomic_order::relaxed);
+		std::atomic_thread_fence(atomic_order::seq_cst);	// NOTE: Pairs with __unpark
+
+		// Commit
+		if(this->run.load(atomic_order::relaxed)
+			 && this->numTasks.load(atomic_order::relaxed) <= this->numProcessing.load(atomic_order::relaxed))
+		{
+			this->epoch.wait(e, atomic_order::acquire);
+		}
+		this->numSleeping.fetch_sub(1, atomic_order::relaxed);
+	}
+	void
+	__thread_pool_storage_t::__unpark() pf_attr_noexcept
+	{
+		std::atomic_thread_fence(atomic_order::seq_cst);	// NOTE: Pairs with __park
+		if(this->numSleeping.load(atomic_order::relaxed) == 0) return;
+		this->epoch.fetch_add(1, atomic_order::release);
+		this->epoch.notify_one();
+	}
+	void
+	__thread_pool_storage_t::__unpark_n(
+	 uint32_t __num) pf_attr_noexcept
+	{
+		std::atomic_thread_fence(atomic_order::seq_cst);	// NOTE: Pairs with __park
+		const uint32_t s = this->numSleeping.load(atomic_order::relaxed);
+		if(s == 0) return;
+		this->epoch.fetch_add(1, atomic_order::release);
+		if(__num >= s)
+		{
+			this->epoch.notify_all();
+			return;
+		}
+		for(uint32_t i = 0; i != __num; ++i) this->epoch.notify_one();
+	}
+	void
+	__thread_pool_storage_t::__unpark_all() pf_attr_noexcept
+	{
+		this->epoch.fetch_add(1, atomic_order::release);
+		this->epoch.notify_all();
 	}
 
 	/// Buffer -> Make
 	__thread_pool_storage_t *
-	__thread_pool_t::__make_storage()
+	__thread_pool_t::__make_storage(
+	 uint32_t __numWorkers,
+	 size_t __capacity)
 	{
 		return new_construct_ex<__thread_pool_storage_t>(
-		 CCY_NUM_WORKERS * sizeof(__thread_t));
+		 __numWorkers * sizeof(__thread_worker_t), this, __numWorkers, __capacity);
 	}
 	void
 	__thread_pool_t::__delete_storage(
@@ -55,47 +460,83 @@ namespace pul
 	/// Thread -> Process
 	int32_t
 	__thread_process(
-	 __thread_pool_storage_t *__buf) pf_attr_noexcept
+	 __thread_pool_storage_t *__buf,
+	 __thread_worker_t *__w) pf_attr_noexcept
 	{
+		// Worker
+		__this_worker = __w;
+		ignore				= this_thread::get_idx();	 // NOTE: Taken now, pools started later count it
+
 		// Security
 		__buf->numProcessing.fetch_add(1, atomic_order::relaxed);
 
+		// Stats
+		__thread_worker_stats_t &stats = __w->stats;
+		high_resolution_point_t since	 = high_resolution_clock_t::now();
+
 		// Worker
 		do
 		{
 			// Stop?
 			if(__buf->numTasks.load(atomic_order::relaxed) < __buf->numProcessing.load(atomic_order::relaxed))
 			{
+				high_resolution_point_t now = high_resolution_clock_t::now();	// NOTE: Clock reads only on busy <-> idle transitions
+				__thread_worker_stats_t::__add(stats.busyTime, static_cast<uint64_t>(duration_cast<nanoseconds_t>(now - since).count()));
+				since = now;
 				__buf->numProcessing.fetch_sub(1, atomic_order::relaxed);
 				{
+					uint32_t s = 0;
 					while(__buf->run.load(atomic_order::relaxed)
 								&& __buf->numTasks.load(atomic_order::relaxed) <= __buf->numProcessing.load(atomic_order::relaxed))
 					{
-						this_thread::yield();
+						if(s < __buf->spinBudget.load(atomic_order::relaxed))
+						{
+							this_thread::yield();
+							++s;
+						}
+						else
+						{
+							__buf->__park();
+							s = 0;
+						}
 					}
 				}
 				__buf->numProcessing.fetch_add(1, atomic_order::relaxed);
+				now = high_resolution_clock_t::now();
+				__thread_worker_stats_t::__add(stats.idleTime, static_cast<uint64_t>(duration_cast<nanoseconds_t>(now - since).count()));
+				since = now;
 			}
 
 			// Process
 			while(__buf->numTasks.load(atomic_order::relaxed) >= __buf->numProcessing.load(atomic_order::relaxed))	// NOTE: Avoid low task overhead
 			{
+				// Depth
+				const uint32_t d = __buf->numTasks.load(atomic_order::relaxed);
+				__thread_worker_stats_t::__add(stats.depthSum, d);
+				__thread_worker_stats_t::__add(stats.numDepthSamples, 1);
+				if(d > stats.depthMax.load(atomic_order::relaxed)) stats.depthMax.store(d, atomic_order::relaxed);
+
+				// Batch
 				uint32_t i	= 0;
-				__task_t *t = __buf->queue.try_dequeue();
+				__task_t *t = __buf->__try_dequeue(__w);
 				while(t)
 				{
 					try
 					{
-						t->__call();
+						t->__run();
 					} catch(std::exception const &)
 					{
 						__dbg_move_exception_record_to_0();
+						__thread_worker_stats_t::__add(stats.numExceptions, 1);
 					}
-					destroy_delete_c(t);
-					t = __buf->queue.try_dequeue();
+					t = __buf->__try_dequeue(__w);
 					++i;
 				};
-				if(i > 0) __buf->numTasks.fetch_sub(i, atomic_order::relaxed);
+				if(i > 0)
+				{
+					__buf->numTasks.fetch_sub(i, atomic_order::relaxed);
+					__thread_worker_stats_t::__add(stats.numExecuted, i);
+				}
 			};
 		} while(__buf->run.load(atomic_order::relaxed) == true);
 
@@ -104,76 +545,451 @@ namespace pul
 		return 0;
 	}
 
-	/// Constructors
-	__thread_pool_t::__thread_pool_t()
+	/// Workers -> Start
+	__thread_pool_storage_t *
+	__thread_pool_t::__start(
+	 uint32_t __numWorkers)
 	{
+		/// Indices
+		pf_throw_if(
+		 this_thread::__idx_num_live() + __numWorkers > CCY_MAX_THREADS,
+		 dbg_category_generic(),
+		 dbg_code::invalid_argument,
+		 dbg_flags::none,
+		 "Too many live threads for this_thread::get_idx to tell apart. numLive={}, numWorkers={}, CCY_MAX_THREADS={}",
+		 this_thread::__idx_num_live(),
+		 __numWorkers,
+		 CCY_MAX_THREADS);
+
 		/// Make Buffer
-		this->buf_ = this->__make_storage();
+		__thread_pool_storage_t *b = this->__make_storage(__numWorkers, this->capacity_);
+
+		/// Workers
+		for(uint32_t i = 0; i != __numWorkers; ++i)
+		{
+			construct(b->__get_worker(i), b, i);
+		}
 
 		/// Threads
-		for(uint32_t i = 0; i != CCY_NUM_WORKERS; ++i)
+		for(uint32_t i = 0; i != __numWorkers; ++i)
 		{
-			construct(this->buf_->__get_thread(i), __thread_process, this->buf_);
+			auto w		= b->__get_worker(i);
+			w->thread = __thread_t(__thread_process, b, w);
+			if(this->affinity_ != thread_affinity::none) __thread_set_affinity(w->thread, this->affinity_, i);
 		}
+		return b;
 	}
 
-	/// Destructor
-	__thread_pool_t::~__thread_pool_t() pf_attr_noexcept
+	/// Workers -> Remaining
+	void
+	__thread_pool_t::__move(
+	 __task_t *__task,
+	 __thread_pool_storage_t *__to,
+	 mpmc_lifo2<__task_t> &__lane) pf_attr_noexcept
+	{
+		if(__lane.try_enqueue(__task))
+		{
+			__to->numTasks.fetch_add(1, atomic_order::relaxed);
+			__to->__unpark();
+			return;
+		}
+		this->__run_caught(__task);	 // NOTE: No room left, run it like the run_inline policy
+	}
+	void
+	__thread_pool_t::__move_0(
+	 __thread_pool_storage_t *__buf,
+	 __thread_pool_storage_t *__to) pf_attr_noexcept
+	{
+		for(__task_t *t = __buf->queue0.try_dequeue(); t; t = __buf->queue0.try_dequeue())
+		{
+			__buf->numTasks0.fetch_sub(1, atomic_order::relaxed);
+			__to->numTasks0.fetch_add(1, atomic_order::relaxed);
+			while(!__to->queue0.try_enqueue(t))
+			{
+				if(this_thread::get_idx() == 0)
+				{
+					__to->numTasks0.fetch_sub(1, atomic_order::relaxed);
+					this->__run_caught(t);
+					break;
+				}
+				this_thread::yield();	 // NOTE: Only the main thread may run it
+			}
+		}
+	}
+	bool
+	__thread_pool_t::__run_0(
+	 __thread_pool_storage_t *__buf) pf_attr_noexcept
+	{
+		bool r = false;
+		for(__task_t *t = __buf->queue0.try_dequeue(); t; t = __buf->queue0.try_dequeue())
+		{
+			__buf->numTasks0.fetch_sub(1, atomic_order::relaxed);
+			this->__run_caught(t);
+			r = true;
+		}
+		return r;
+	}
+
+	/// Workers -> Stop
+	void
+	__thread_pool_t::__stop(
+	 __thread_pool_storage_t *__buf,
+	 __thread_pool_storage_t *__to) pf_attr_noexcept
 	{
 		/// Stop the run
-		this->buf_->run.store(false, atomic_order::release);
-		while(this->buf_->numProcessing.load(atomic_order::relaxed) != 2 * CCY_NUM_WORKERS) process_tasks_0();	// Waits for all workers to terminate
+		const uint32_t n = __buf->numWorkers;
+		__buf->run.store(false, atomic_order::release);
+		__buf->__unpark_all();
+		while(__buf->numProcessing.load(atomic_order::relaxed) != 2 * n)	// Waits for all workers to terminate
+		{
+			// NOTE: A worker blocked on a full queue0 waits for room, only the main thread runs queue0 tasks
+			if(__to) this->__move_0(__buf, __to);
+			else if(this_thread::get_idx() == 0) ignore = this->__run_0(__buf);
+			this_thread::yield();
+		}
 
 		/// Threads
-		for(uint32_t i = 0; i < CCY_NUM_WORKERS; ++i)
+		for(uint32_t i = 0; i < n; ++i)
 		{
-			auto t = this->buf_->__get_thread(i);
+			auto t = __buf->__get_thread(i);
 			if(t->joinable()) t->join();
 		}
 
-		/// Process Remaining
-		while(this->__process())
-			;
-		while(this->__process_0() > 0)
-			;
+		/// Remaining
+		if(__to)
+		{
+			// Restart -> The new workers run them
+			__task_t *t = nullptr;
+			while((t = __buf->queueC.try_dequeue())) this->__move(t, __to, __to->queueC);
+			while((t = __buf->queue.try_dequeue())) this->__move(t, __to, __to->queue);
+			while((t = __buf->__try_steal(0))) this->__move(t, __to, __to->queue);
+			while((t = __buf->queueB.try_dequeue())) this->__move(t, __to, __to->queueB);
+			this->__move_0(__buf, __to);
+		}
+		else
+		{
+			// Destroy -> Run here, tasks they submit land in this storage too
+			// NOTE: Only the global pool has queue0 tasks, the main thread destroys it
+			bool r = true;
+			while(r)
+			{
+				r = false;
+				for(__task_t *t = __buf->__try_dequeue(nullptr); t; t = __buf->__try_dequeue(nullptr))
+				{
+					this->__run_caught(t);
+					r = true;
+				}
+				if(this_thread::get_idx() == 0 && this->__run_0(__buf)) r = true;
+			}
+		}
+
+		/// Workers
+		for(uint32_t i = 0; i < n; ++i)
+		{
+			destroy(__buf->__get_worker(i));
+		}
 
 		/// Buffer
-		this->__delete_storage(this->buf_);
+		this->__delete_storage(__buf);
+	}
+
+	/// Workers -> Restart
+	pf_decl_static void
+	__thread_pool_check_restart(
+	 __thread_pool_t *__pool)
+	{
+		pf_throw_if(
+		 __epoch_this_record()->nesting != 0,
+		 dbg_category_generic(),
+		 dbg_code::runtime_error,
+		 dbg_flags::none,
+		 "A pool can't be restarted from inside one of its submissions, it would wait for itself!");
+		pf_throw_if(
+		 __this_worker && __this_worker->owner->pool == __pool,	// NOTE: Any storage of the pool, an older one is stopped under the lock we'd wait for
+		 dbg_category_generic(),
+		 dbg_code::runtime_error,
+		 dbg_flags::none,
+		 "A pool can't be restarted from one of its own workers, it would wait for itself!");
 	}
 
-	/// Submit
 	void
-	__thread_pool_t::__submit(
-	 __task_t *__task)
+	__thread_pool_t::__restart(
+	 uint32_t __numWorkers)
 	{
-		// Add
-		if(!this->buf_->queue.try_enqueue(__task))
+		// NOTE: The new workers start first, submitters that loaded the old storage are waited for before it's drained
+		__thread_pool_storage_t *o = this->buf_.load(atomic_order::relaxed);
+		__thread_pool_storage_t *b = this->__start(__numWorkers);
+		b->spinBudget.store(o->spinBudget.load(atomic_order::relaxed), atomic_order::relaxed);
+		this->buf_.store(b, atomic_order::seq_cst);
+		epoch_synchronize();
+		this->__stop(o, b);
+	}
+
+	/// Workers -> Local
+	__thread_worker_t *
+	__thread_pool_t::__local_worker(
+	 __thread_pool_storage_t *__buf) const pf_attr_noexcept
+	{
+		return __this_worker && __this_worker->owner == __buf ? __this_worker : nullptr;	// NOTE: Workers of other pools have no deque here
+	}
+
+	/// Capacity -> Slots
+	pf_hint_nodiscard pf_decl_static size_t
+	__thread_pool_slots(
+	 size_t __capacity) pf_attr_noexcept
+	{
+		if(__capacity == 0) __capacity = CCY_TASKS_MAX_NUM * CCY_NUM_THREADS;
+		size_t n = (__capacity + CCY_NUM_THREADS - 1) / CCY_NUM_THREADS;
+		if(n <= CCY_NUM_THREADS * 64) n = CCY_NUM_THREADS * 64 + 1;	// NOTE: Lower bound of mpmc_lifo2
+		size_t s = 1;
+		while(s < n) s <<= 1;	 // NOTE: Indices wrap at 2^32, a power of two keeps the slots continuous
+		return s;
+	}
+
+	/// Constructors
+	__thread_pool_t::__thread_pool_t(
+	 uint32_t __numWorkers,
+	 size_t __capacity)
+		: buf_(nullptr)
+		, affinity_(thread_affinity::none)
+		, capacity_(__thread_pool_slots(__capacity))
+		, overflow_(task_overflow::block)
+	{
+		this->buf_.store(this->__start(__numWorkers == 0 ? 1 : __numWorkers), atomic_order::release);
+	}
+
+	/// Destructor
+	__thread_pool_t::~__thread_pool_t() pf_attr_noexcept
+	{
+		this->__stop(this->buf_.load(atomic_order::relaxed), nullptr);	// NOTE: Tasks submitted while draining land in the storage being stopped
+		this->buf_.store(nullptr, atomic_order::relaxed);
+	}
+
+	/// Workers
+	uint32_t
+	__thread_pool_t::__num_workers() const pf_attr_noexcept
+	{
+		epoch_guard g;
+		return this->buf_.load(atomic_order::acquire)->numWorkers;
+	}
+	void
+	__thread_pool_t::__resize(
+	 uint32_t __numWorkers)
+	{
+		__thread_pool_check_restart(this);
+		lock_unique<mutex_t> lck(this->mutex_);
+		if(__numWorkers == 0) __numWorkers = 1;
+		if(__numWorkers == this->buf_.load(atomic_order::relaxed)->numWorkers) return;
+		this->__restart(__numWorkers);
+	}
+
+	/// Capacity
+	size_t
+	__thread_pool_t::__capacity() const pf_attr_noexcept
+	{
+		epoch_guard g;
+		return this->buf_.load(atomic_order::acquire)->capacity * CCY_NUM_THREADS;
+	}
+	void
+	__thread_pool_t::__set_capacity(
+	 size_t __capacity)
+	{
+		__thread_pool_check_restart(this);
+		lock_unique<mutex_t> lck(this->mutex_);
+		const size_t s = __thread_pool_slots(__capacity);
+		if(s == this->capacity_) return;
+		const size_t c	= this->capacity_;
+		this->capacity_ = s;
+		try
 		{
-			pf_throw(
-			 dbg_category_generic(),
-			 dbg_code::runtime_error,
-			 0,
-			 "Problem when adding a task to the shared queue. task={}",
-			 union_cast<void *>(__task));
-			return;
+			this->__restart(this->buf_.load(atomic_order::relaxed)->numWorkers);
+		} catch(...)
+		{
+			this->capacity_ = c;
+			throw;
 		}
+	}
+	uint32_t
+	__thread_pool_t::__num_pending() const pf_attr_noexcept
+	{
+		epoch_guard g;
+		return this->buf_.load(atomic_order::acquire)->numTasks.load(atomic_order::relaxed);
+	}
 
-		// Notify
-		this->buf_->numTasks.fetch_add(1, atomic_order::relaxed);
+	/// Overflow
+	task_overflow
+	__thread_pool_t::__get_overflow() const pf_attr_noexcept
+	{
+		return this->overflow_.load(atomic_order::relaxed);
+	}
+	void
+	__thread_pool_t::__set_overflow(
+	 task_overflow __policy) pf_attr_noexcept
+	{
+		this->overflow_.store(__policy, atomic_order::relaxed);
 	}
 	void
+	__thread_pool_t::__wait_for_room() pf_attr_noexcept
+	{
+		if(!this->__help()) this_thread::yield();	 // NOTE: Helping frees a slot, workers of this pool can't deadlock on a full queue
+	}
+
+	/// Submit
+	// NOTE: The epoch is only pinned around storage accesses, user code runs unpinned
+	bool
+	__thread_pool_t::__submit(
+	 __task_t *__task,
+	 task_overflow __policy)
+	{
+		while(true)
+		{
+			// Add
+			{
+				epoch_guard g;
+				__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+				__thread_worker_t *w			 = this->__local_worker(b);
+				if((w && w->deque.try_push(__task)) || b->queue.try_enqueue(__task))
+				{
+					b->numTasks.fetch_add(1, atomic_order::relaxed);
+					b->__unpark();
+					return true;
+				}
+			}
+
+			// Full
+			switch(__policy)
+			{
+				case task_overflow::fail: return false;
+				case task_overflow::run_inline: __task->__run(); return true;	 // NOTE: The pool isn't notified, the caller ran it
+				default: this->__wait_for_room(); break;
+			}
+		}
+	}
+	bool
+	__thread_pool_t::__submit(
+	 task_priority __priority,
+	 __task_t *__task,
+	 task_overflow __policy)
+	{
+		if(__priority == task_priority::normal) return this->__submit(__task, __policy);
+		while(true)
+		{
+			// Add
+			{
+				epoch_guard g;
+				__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+				mpmc_lifo2<__task_t> *q		 = __priority == task_priority::critical ? &b->queueC : &b->queueB;
+				if(q->try_enqueue(__task))
+				{
+					b->numTasks.fetch_add(1, atomic_order::relaxed);
+					b->__unpark();
+					return true;
+				}
+			}
+
+			// Full
+			switch(__policy)
+			{
+				case task_overflow::fail: return false;
+				case task_overflow::run_inline: __task->__run(); return true;
+				default: this->__wait_for_room(); break;
+			}
+		}
+	}
+	bool
 	__thread_pool_t::__submit_0(
-	 __task_t *__task)
+	 __task_t *__task,
+	 task_overflow __policy)
 	{
-		if(!this->buf_->queue0.try_enqueue(__task))
+		while(true)
 		{
-			pf_throw(
-			 dbg_category_generic(),
-			 dbg_code::runtime_error,
-			 0,
-			 "Problem when adding a task to the main queue. task={}",
-			 union_cast<void *>(__task));
-			return;
+			// Add
+			{
+				epoch_guard g;
+				__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+				b->numTasks0.fetch_add(1, atomic_order::relaxed);	 // NOTE: Counted first, a dequeue mustn't see it below zero
+				if(b->queue0.try_enqueue(__task)) return true;
+				b->numTasks0.fetch_sub(1, atomic_order::relaxed);
+			}
+
+			// Full
+			if(__policy == task_overflow::fail) return false;
+			if(__policy == task_overflow::run_inline || this_thread::get_idx() == 0)
+			{
+				__task->__run();	// NOTE: The main thread can't wait for itself to drain its queue
+				return true;
+			}
+			this_thread::yield();
+		}
+	}
+
+	size_t
+	__thread_pool_t::__submit_bulk(
+	 __task_t **__beg,
+	 __task_t **__end,
+	 task_overflow __policy)
+	{
+		size_t r = 0;
+		while(true)
+		{
+			// Add
+			{
+				epoch_guard g;
+				__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+				uint32_t n								 = 0;
+
+				// Add -> Local
+				__thread_worker_t *w = this->__local_worker(b);
+				if(w)
+				{
+					while(__beg != __end && w->deque.try_push(*__beg))
+					{
+						++__beg;
+						++n;
+					}
+				}
+
+				// Add -> Shared
+				size_t k = countof(__beg, __end);
+				while(__beg != __end)
+				{
+					if(k > b->capacity) k = b->capacity;
+					if(b->queue.try_enqueue_bulk(iterator<__task_t *>(__beg), iterator<__task_t *>(__beg + k)))
+					{
+						__beg += k;
+						n			+= static_cast<uint32_t>(k);
+						k			 = countof(__beg, __end);
+					}
+					else if(k > 1)
+					{
+						k /= 2;	 // NOTE: Not enough room on a single list, split the batch
+					}
+					else
+					{
+						break;
+					}
+				}
+
+				// Notify -> Workers only look for counted tasks
+				b->numTasks.fetch_add(n, atomic_order::relaxed);
+				b->__unpark_n(n);
+				r += n;
+				if(__beg == __end) return r;
+			}
+
+			// Full
+			if(__policy == task_overflow::fail) return r;
+			if(__policy == task_overflow::run_inline)
+			{
+				while(__beg != __end)
+				{
+					(*__beg)->__run();
+					++__beg;
+					++r;
+				}
+				return r;
+			}
+			this->__wait_for_room();
 		}
 	}
 
@@ -181,43 +997,407 @@ namespace pul
 	bool
 	__thread_pool_t::__process()
 	{
-		__task_t *t = this->buf_->queue.try_dequeue();
-		if(t)
+		__task_t *t = nullptr;
+		{
+			epoch_guard g;
+			__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+			t													 = b->__try_dequeue(this->__local_worker(b));
+			if(!t) return false;
+			b->numTasks.fetch_sub(1, atomic_order::relaxed);
+		}
+		t->__run();
+		return true;
+	}
+	bool
+	__thread_pool_t::__help() pf_attr_noexcept
+	{
+		if(__help_depth == CCY_HELP_MAX_DEPTH) return false;
+		__task_t *t						= nullptr;
+		__thread_worker_t *w	= nullptr;	// NOTE: Only set on a worker of this storage, which outlives the run
+		{
+			epoch_guard g;
+			__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+			w													 = this->__local_worker(b);
+			t													 = b->__try_dequeue(w);
+			if(!t) return false;
+			b->numTasks.fetch_sub(1, atomic_order::relaxed);
+		}
+		__thread_help_run(t, w);
+		return true;
+	}
+	bool
+	__thread_pool_t::__help_0() pf_attr_noexcept
+	{
+		if(__help_depth == CCY_HELP_MAX_DEPTH) return false;
+		__task_t *t = nullptr;
 		{
-			t->__call();
-			destroy_delete_c(t);
-			this->buf_->numTasks.fetch_sub(1, atomic_order::relaxed);
-			return true;
+			epoch_guard g;
+			__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+			t													 = b->queue0.try_dequeue();
+			if(!t) return false;
+			b->numTasks0.fetch_sub(1, atomic_order::relaxed);
 		}
-		return false;
+		++__help_depth;
+		this->__run_caught(t);
+		--__help_depth;
+		return true;
+	}
+	void
+	__thread_pool_t::__run_caught(
+	 __task_t *__task) pf_attr_noexcept
+	{
+		try
+		{
+			__task->__run();
+		} catch(std::exception const &)
+		{
+			if(this_thread::get_idx() != 0) __dbg_move_exception_record_to_0();
+			else if(!this->exception0_) this->exception0_ = std::current_exception();	// NOTE: Raised by the next process_tasks_0
+		}
+	}
+	void
+	__thread_pool_t::__rethrow_0()
+	{
+		if(pf_likely(!this->exception0_)) return;
+		std::exception_ptr e = std::move(this->exception0_);
+		this->exception0_		 = nullptr;
+		std::rethrow_exception(std::move(e));
 	}
 	uint32_t
 	__thread_pool_t::__process_0()
 	{
-		__task_t *t[32]	 = { nullptr };
-		const uint32_t i = union_cast<uint32_t>(this->buf_->queue0.try_dequeue_bulk(begin(t), end(t)));
-		uint32_t j			 = 0;
-		while(j != i)
+		this->__rethrow_0();
+		__task_t *t[32] = { nullptr };
+		uint32_t i			= 0;
 		{
-			t[j]->__call();
-			destroy_delete_c(t[j]);
-			++j;
+			epoch_guard g;
+			__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+			i													 = union_cast<uint32_t>(b->queue0.try_dequeue_bulk(begin(t), end(t)));
+			if(i > 0) b->numTasks0.fetch_sub(i, atomic_order::relaxed);
+		}
+		uint32_t j = 0;
+		try
+		{
+			while(j != i)
+			{
+				t[j]->__run();
+				++j;
+			}
+		} catch(...)
+		{
+			for(++j; j != i; ++j) ignore = this->__submit_0(t[j], task_overflow::block);	// NOTE: Dequeued but not run, they go back
+			throw;
 		}
 		return i;
 	}
+	uint32_t
+	__thread_pool_t::__process_0_until(
+	 high_resolution_point_t __deadline)
+	{
+		this->__rethrow_0();
+		while(high_resolution_clock_t::now() < __deadline)	// NOTE: One at a time, what isn't run stays queued in order
+		{
+			__task_t *t = nullptr;
+			{
+				epoch_guard g;
+				__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+				t													 = b->queue0.try_dequeue();
+				if(!t) break;
+				b->numTasks0.fetch_sub(1, atomic_order::relaxed);
+			}
+			t->__run();
+		}
+		epoch_guard g;
+		return this->buf_.load(atomic_order::acquire)->numTasks0.load(atomic_order::relaxed);
+	}
+
+	/// Spin Budget
+	uint32_t
+	__thread_pool_t::__get_spin_budget() const pf_attr_noexcept
+	{
+		epoch_guard g;
+		return this->buf_.load(atomic_order::acquire)->spinBudget.load(atomic_order::relaxed);
+	}
+	void
+	__thread_pool_t::__set_spin_budget(
+	 uint32_t __budget) pf_attr_noexcept
+	{
+		epoch_guard g;
+		this->buf_.load(atomic_order::acquire)->spinBudget.store(__budget, atomic_order::relaxed);	 // NOTE: A restart copies it to the new storage
+	}
+
+	/// Stats
+	thread_pool_stats_t
+	__thread_pool_t::__stats() const pf_attr_noexcept
+	{
+		epoch_guard g;
+		__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+		thread_pool_stats_t s			 = {};
+		for(uint32_t i = 0; i != b->numWorkers; ++i)
+		{
+			const thread_pool_stats_t w = b->__get_worker(i)->stats.__snapshot();
+			s.numExecuted							 += w.numExecuted;
+			s.numExceptions						 += w.numExceptions;
+			s.numLocal								 += w.numLocal;
+			s.numShared								 += w.numShared;
+			s.numStolen								 += w.numStolen;
+			s.numMisses								 += w.numMisses;
+			s.busyTime								 += w.busyTime;
+			s.idleTime								 += w.idleTime;
+			s.depthSum								 += w.depthSum;
+			s.numDepthSamples					 += w.numDepthSamples;
+			if(w.depthMax > s.depthMax) s.depthMax = w.depthMax;
+		}
+		return s;
+	}
+	thread_pool_stats_t
+	__thread_pool_t::__worker_stats(
+	 uint32_t __index) const
+	{
+		epoch_guard g;
+		__thread_pool_storage_t *b = this->buf_.load(atomic_order::acquire);
+		pf_throw_if(
+		 __index >= b->numWorkers,
+		 dbg_category_generic(),
+		 dbg_code::invalid_argument,
+		 dbg_flags::none,
+		 "__index is out of range. __index={}, numWorkers={}",
+		 __index,
+		 b->numWorkers);
+		return b->__get_worker(__index)->stats.__snapshot();
+	}
+
+	/// Affinity
+	thread_affinity
+	__thread_pool_t::__get_affinity() const pf_attr_noexcept
+	{
+		return this->affinity_;
+	}
+	bool
+	__thread_pool_t::__set_affinity(
+	 thread_affinity __affinity) pf_attr_noexcept
+	{
+		lock_unique<mutex_t> lck(this->mutex_);
+		__thread_pool_storage_t *b = this->buf_.load(atomic_order::relaxed);
+		bool r										 = true;
+		for(uint32_t i = 0; i != b->numWorkers; ++i)
+		{
+			r &= __thread_set_affinity(*b->__get_thread(i), __affinity, i);
+		}
+		this->affinity_ = __affinity;
+		return r;
+	}
 
 	/// CONCURRENCY: Task -> Enqueue
 	pulsar_api void
 	__task_enqueue_0(
 	 __task_t *__task) pf_attr_noexcept
 	{
-		__internal.thread_pool.__submit_0(__task);
+		(void)__internal.thread_pool.__submit_0(__task, task_overflow::block);
 	}
 	pulsar_api void
 	__task_enqueue(
 	 __task_t *__task) pf_attr_noexcept
 	{
-		__internal.thread_pool.__submit(__task);
+		(void)__internal.thread_pool.__submit(__task, task_overflow::block);
+	}
+	pulsar_api void
+	__task_enqueue(
+	 task_priority __priority,
+	 __task_t *__task) pf_attr_noexcept
+	{
+		(void)__internal.thread_pool.__submit(__priority, __task, task_overflow::block);
+	}
+
+	/// CONCURRENCY: Task -> Submit
+	pulsar_api bool
+	__task_submit_0(
+	 __task_t *__task,
+	 task_overflow __policy)
+	{
+		return __internal.thread_pool.__submit_0(__task, __policy);
+	}
+	pulsar_api bool
+	__task_submit(
+	 __task_t *__task,
+	 task_overflow __policy)
+	{
+		return __internal.thread_pool.__submit(__task, __policy);
+	}
+	pulsar_api bool
+	__task_submit(
+	 task_priority __priority,
+	 __task_t *__task,
+	 task_overflow __policy)
+	{
+		return __internal.thread_pool.__submit(__priority, __task, __policy);
+	}
+	pulsar_api size_t
+	__task_submit_bulk(
+	 __task_t **__beg,
+	 __task_t **__end,
+	 task_overflow __policy)
+	{
+		return __internal.thread_pool.__submit_bulk(__beg, __end, __policy);
+	}
+
+	/// CONCURRENCY: Thread Pool -> Instance
+	pulsar_api __thread_pool_t *
+	__thread_pool_new(
+	 uint32_t __numWorkers,
+	 size_t __capacity)
+	{
+		return new_construct<__thread_pool_t>(__numWorkers, __capacity);
+	}
+	pulsar_api void
+	__thread_pool_delete(
+	 __thread_pool_t *__pool) pf_attr_noexcept
+	{
+		destroy_delete(__pool);
+	}
+	pulsar_api bool
+	__thread_pool_enqueue(
+	 __thread_pool_t *__pool,
+	 __task_t *__task)
+	{
+		return __pool->__submit(__task, __pool->__get_overflow());
+	}
+	pulsar_api bool
+	__thread_pool_process(
+	 __thread_pool_t *__pool)
+	{
+		return __pool->__process();
+	}
+	pulsar_api uint32_t
+	__thread_pool_num_workers(
+	 __thread_pool_t *__pool) pf_attr_noexcept
+	{
+		return __pool->__num_workers();
+	}
+	pulsar_api void
+	__thread_pool_resize(
+	 __thread_pool_t *__pool,
+	 uint32_t __numWorkers)
+	{
+		__pool->__resize(__numWorkers);
+	}
+	pulsar_api uint32_t
+	__thread_pool_num_pending(
+	 __thread_pool_t *__pool) pf_attr_noexcept
+	{
+		return __pool->__num_pending();
+	}
+	pulsar_api task_overflow
+	__thread_pool_overflow(
+	 __thread_pool_t *__pool) pf_attr_noexcept
+	{
+		return __pool->__get_overflow();
+	}
+	pulsar_api void
+	__thread_pool_set_overflow(
+	 __thread_pool_t *__pool,
+	 task_overflow __policy) pf_attr_noexcept
+	{
+		__pool->__set_overflow(__policy);
+	}
+
+	/// CONCURRENCY: Thread Pool -> Workers
+	pulsar_api uint32_t
+	thread_pool_num_workers() pf_attr_noexcept
+	{
+		return __internal.thread_pool.__num_workers();
+	}
+	pulsar_api void
+	thread_pool_resize(
+	 uint32_t __numWorkers)
+	{
+		__internal.thread_pool.__resize(__numWorkers);
+	}
+
+	/// CONCURRENCY: Thread Pool -> Capacity
+	pulsar_api size_t
+	thread_pool_capacity() pf_attr_noexcept
+	{
+		return __internal.thread_pool.__capacity();
+	}
+	pulsar_api void
+	thread_pool_set_capacity(
+	 size_t __capacity)
+	{
+		__internal.thread_pool.__set_capacity(__capacity);
+	}
+	pulsar_api uint32_t
+	thread_pool_num_pending() pf_attr_noexcept
+	{
+		return __internal.thread_pool.__num_pending();
+	}
+
+	/// CONCURRENCY: Thread Pool -> Overflow
+	pulsar_api task_overflow
+	thread_pool_overflow() pf_attr_noexcept
+	{
+		return __internal.thread_pool.__get_overflow();
+	}
+	pulsar_api void
+	thread_pool_set_overflow(
+	 task_overflow __policy) pf_attr_noexcept
+	{
+		__internal.thread_pool.__set_overflow(__policy);
+	}
+
+	/// CONCURRENCY: Thread Pool -> Stats
+	pulsar_api thread_pool_stats_t
+	thread_pool_stats() pf_attr_noexcept
+	{
+		return __internal.thread_pool.__stats();
+	}
+	pulsar_api thread_pool_stats_t
+	thread_pool_worker_stats(
+	 uint32_t __index)
+	{
+		return __internal.thread_pool.__worker_stats(__index);
+	}
+
+	/// CONCURRENCY: Thread Pool -> Affinity
+	pulsar_api thread_affinity
+	thread_pool_affinity() pf_attr_noexcept
+	{
+		return __internal.thread_pool.__get_affinity();
+	}
+	pulsar_api bool
+	thread_pool_set_affinity(
+	 thread_affinity __affinity) pf_attr_noexcept
+	{
+		return __internal.thread_pool.__set_affinity(__affinity);
+	}
+
+	/// CONCURRENCY: Task -> Slab
+	pulsar_api void *
+	__task_slab_allocate(
+	 size_t __size,
+	 size_t __align)
+	{
+		return __internal.task_slab.__allocate(__size, __align);
+	}
+	pulsar_api void
+	__task_slab_deallocate(
+	 void *__ptr) pf_attr_noexcept
+	{
+		__internal.task_slab.__deallocate(__ptr);
+	}
+	pulsar_api size_t
+	thread_pool_num_allocations() pf_attr_noexcept
+	{
+		return __internal.task_slab.__num_allocations();
+	}
+
+	/// CONCURRENCY: Task -> Help
+	pulsar_api bool
+	__task_help() pf_attr_noexcept
+	{
+		if(__this_worker) return __this_worker->owner->__help(__this_worker);
+		if(this_thread::get_idx() == 0 && __internal.thread_pool.__help_0()) return true;	 // NOTE: A worker blocked on a full queue0 only waits for main
+		return __internal.thread_pool.__help();
 	}
 
 	/// CONCURRENCY: Task -> Process
@@ -231,4 +1411,29 @@ namespace pul
 	{
 		return __internal.thread_pool.__process_0();
 	}
+	pulsar_api uint32_t
+	process_tasks_0_for(
+	 nanoseconds_t __budget)
+	{
+		return __internal.thread_pool.__process_0_until(high_resolution_clock_t::now() + duration_cast<high_resolution_clock_t::duration>(__budget));
+	}
+	pulsar_api uint32_t
+	process_tasks_0_until(
+	 high_resolution_point_t __deadline)
+	{
+		return __internal.thread_pool.__process_0_until(__deadline);
+	}
+
+	/// CONCURRENCY: Task -> Spin Budget
+	pulsar_api uint32_t
+	thread_pool_spin_budget() pf_attr_noexcept
+	{
+		return __internal.thread_pool.__get_spin_budget();
+	}
+	pulsar_api void
+	thread_pool_set_spin_budget(
+	 uint32_t __budget) pf_attr_noexcept
+	{
+		__internal.thread_pool.__set_spin_budget(__budget);
+	}
 }	 // namespace pul
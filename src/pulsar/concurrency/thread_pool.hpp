@@ -23,17 +23,198 @@
 namespace pul
 {
 	/// TASK Constants
-	pf_decl_constexpr size_t CCY_TASKS_MAX_NUM	 = 8'192;
-	pf_decl_constexpr size_t CCY_TASKS_MAX_NUM_0 = 4'096;
+	pf_decl_constexpr size_t CCY_TASKS_MAX_NUM	 = 8'192;	// NOTE: Default slots per thread list of each lane
+	pf_decl_constexpr size_t CCY_TASKS_MAX_NUM_W = 2'048;
+	pf_decl_constexpr uint32_t CCY_SPIN_BUDGET	 = 64;
+	pf_decl_constexpr uint32_t CCY_AGING_PERIOD	 = 32;	// NOTE: Background lane is served first every N dequeues
+
+	/// TASK: Slab -> Constants
+	pf_decl_constexpr size_t CCY_TASK_SLAB_CHUNK_SIZE	 = 65'536;	// NOTE: Chunks are aligned on their size, a block finds its chunk by masking
+	pf_decl_constexpr size_t CCY_TASK_SLAB_MIN_SIZE		 = 64;
+	pf_decl_constexpr uint32_t CCY_TASK_SLAB_NUM_BINS = 4;	// 64, 128, 256, 512
+
+	/// TASK: Slab -> Block
+	struct __task_slab_block_t
+	{
+		__task_slab_block_t *next;
+	};
+
+	/// TASK: Slab -> Chunk
+	struct __task_slab_cache_t;
+	struct __task_slab_chunk_t
+	{
+		pf_alignas(CCY_ALIGN) __task_slab_cache_t *owner;
+		__task_slab_chunk_t *next;
+		uint32_t bin;
+	};
+
+	/// TASK: Slab -> Bin
+	struct __task_slab_bin_t
+	{
+		pf_alignas(CCY_ALIGN) atomic<__task_slab_block_t *> remote;	 // Blocks freed by other threads
+		__task_slab_block_t *local;
+		__task_slab_chunk_t *chunks;
+	};
+
+	/// TASK: Slab -> Cache
+	struct __task_slab_cache_t
+	{
+		/// Constructors
+		__task_slab_cache_t() pf_attr_noexcept;
+		__task_slab_cache_t(__task_slab_cache_t const &) = delete;
+		__task_slab_cache_t(__task_slab_cache_t &&)			 = delete;
+
+		/// Destructor
+		~__task_slab_cache_t() pf_attr_noexcept;
+
+		/// Operator =
+		__task_slab_cache_t &
+		operator=(
+		 __task_slab_cache_t const &) = delete;
+		__task_slab_cache_t &
+		operator=(
+		 __task_slab_cache_t &&) = delete;
+
+		/// Allocate
+		pf_hint_nodiscard void *
+		__allocate(
+		 uint32_t __bin,
+		 atomic<size_t> &__numAllocations);
+
+		/// Store
+		__task_slab_bin_t bins[CCY_TASK_SLAB_NUM_BINS];
+		__task_slab_cache_t *next;
+		__task_slab_cache_t *nextOrphan;
+	};
+
+	/// TASK: Slab
+	class __task_slab_t
+	{
+	public:
+		/// Constructors
+		__task_slab_t() pf_attr_noexcept;
+		__task_slab_t(__task_slab_t const &) = delete;
+		__task_slab_t(__task_slab_t &&)			 = delete;
+
+		/// Destructor
+		~__task_slab_t() pf_attr_noexcept;
+
+		/// Operator =
+		__task_slab_t &
+		operator=(
+		 __task_slab_t const &) = delete;
+		__task_slab_t &
+		operator=(
+		 __task_slab_t &&) = delete;
+
+		/// Allocate
+		pf_hint_nodiscard void *
+		__allocate(
+		 size_t __size,
+		 size_t __align);
+		void
+		__deallocate(
+		 void *__ptr) pf_attr_noexcept;
+
+		/// Allocations
+		pf_hint_nodiscard size_t
+		__num_allocations() const pf_attr_noexcept;
+
+		/// Cache -> Orphan
+		void
+		__orphan(
+		 __task_slab_cache_t *__cache) pf_attr_noexcept;
+
+	private:
+		/// Cache
+		pf_hint_nodiscard __task_slab_cache_t *
+		__get_cache();
+
+		/// Store
+		atomic<__task_slab_cache_t *> caches_;	// NOTE: Every cache ever made, freed with the slab
+		atomic<size_t> numAllocations_;
+		__task_slab_cache_t *orphans_;	// NOTE: Caches of exited threads, adopted by the next new ones
+		mutex_t mutex_;
+	};
 
 	/// Type -> Thread
 	using __thread_t = std::thread;
 
+	/// TASK: Pool -> Worker -> Stats
+	struct __thread_worker_stats_t
+	{
+		/// Add
+		pf_decl_static pf_decl_inline void
+		__add(
+		 atomic<uint64_t> &__counter,
+		 uint64_t __val) pf_attr_noexcept
+		{
+			__counter.store(__counter.load(atomic_order::relaxed) + __val, atomic_order::relaxed);	// NOTE: Single writer, no RMW needed
+		}
+
+		/// Snapshot
+		pf_hint_nodiscard thread_pool_stats_t
+		__snapshot() const pf_attr_noexcept;
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<uint64_t> numExecuted;
+		atomic<uint64_t> numExceptions;
+		atomic<uint64_t> numLocal;
+		atomic<uint64_t> numShared;
+		atomic<uint64_t> numStolen;
+		atomic<uint64_t> numMisses;
+		atomic<uint64_t> busyTime;
+		atomic<uint64_t> idleTime;
+		atomic<uint64_t> depthSum;
+		atomic<uint64_t> numDepthSamples;
+		atomic<uint32_t> depthMax;
+	};
+
+	/// TASK: Pool -> Worker
+	struct __thread_pool_storage_t;
+	struct __thread_worker_t
+	{
+		/// Constructors
+		__thread_worker_t(
+		 __thread_pool_storage_t *__owner,
+		 uint32_t __index) pf_attr_noexcept;
+		__thread_worker_t(__thread_worker_t const &) = delete;
+		__thread_worker_t(__thread_worker_t &&)			 = delete;
+
+		/// Destructor
+		~__thread_worker_t() pf_attr_noexcept = default;
+
+		/// Operator =
+		__thread_worker_t &
+		operator=(
+		 __thread_worker_t const &) = delete;
+		__thread_worker_t &
+		operator=(
+		 __thread_worker_t &&) = delete;
+
+		/// Victim
+		pf_hint_nodiscard uint32_t
+		__next_victim() pf_attr_noexcept;
+
+		/// Store
+		pf_alignas(CCY_ALIGN) spmc_deque<__task_t> deque;
+		__thread_pool_storage_t *owner;
+		uint32_t index;
+		uint32_t seed;
+		uint32_t aging;
+		__thread_t thread;
+		__thread_worker_stats_t stats;	// NOTE: Written by this worker only
+	};
+
 	/// TASK: Pool -> Buffer
+	class __thread_pool_t;
 	struct __thread_pool_storage_t
 	{
 		/// Constructors
-		__thread_pool_storage_t() pf_attr_noexcept;
+		__thread_pool_storage_t(
+		 __thread_pool_t *__pool,
+		 uint32_t __numWorkers,
+		 size_t __capacity) pf_attr_noexcept;
 		__thread_pool_storage_t(__thread_pool_storage_t const &) = delete;
 		__thread_pool_storage_t(__thread_pool_storage_t &&)			 = delete;
 
@@ -41,10 +222,39 @@ namespace pul
 		~__thread_pool_storage_t() pf_attr_noexcept = default;
 
 		/// Thread
+		pf_hint_nodiscard __thread_worker_t *
+		__get_worker(
+		 uint32_t __index) pf_attr_noexcept;
 		pf_hint_nodiscard __thread_t *
 		__get_thread(
 		 uint32_t __index) pf_attr_noexcept;
 
+		/// Steal
+		pf_hint_nodiscard __task_t *
+		__try_steal(
+		 uint32_t __first) pf_attr_noexcept;
+
+		/// Dequeue
+		pf_hint_nodiscard __task_t *
+		__try_dequeue(
+		 __thread_worker_t *__w) pf_attr_noexcept;
+
+		/// Help
+		bool
+		__help(
+		 __thread_worker_t *__w) pf_attr_noexcept;
+
+		/// Parking
+		void
+		__park() pf_attr_noexcept;
+		void
+		__unpark() pf_attr_noexcept;
+		void
+		__unpark_n(
+		 uint32_t __num) pf_attr_noexcept;
+		void
+		__unpark_all() pf_attr_noexcept;
+
 		/// Operator =
 		__thread_pool_storage_t &
 		operator=(
@@ -54,14 +264,22 @@ namespace pul
 		 __thread_pool_storage_t &&) = delete;
 
 		/// Store
+		__thread_pool_t *const pool;
+		const uint32_t numWorkers;
+		const size_t capacity;	// Slots per thread list of each lane
 		pf_alignas(CCY_ALIGN) atomic<bool> run;
 		pf_alignas(CCY_ALIGN) atomic<uint32_t> numTasks;
 		pf_alignas(CCY_ALIGN) atomic<uint32_t> numProcessing;
-		// condition_variable_t cv;
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> numSleeping;
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> numTasks0;	 // Main thread tasks still queued
+		pf_alignas(CCY_ALIGN) atomic<uint32_t> epoch;	 // Eventcount
+		atomic<uint32_t> spinBudget;
+		mpmc_lifo2<__task_t> queueC;	// Critical
 		mpmc_lifo2<__task_t> queue;
+		mpmc_lifo2<__task_t> queueB;	// Background
 		mpmc_lifo2<__task_t> queue0;	// Will use bulks
-		byte_t store[];								// [t1][t2][tn-1]
-																	//     workers
+		pf_alignas(CCY_ALIGN) byte_t store[];	 // [w1][w2][wn-1]
+																					 //     workers
 	};
 
 	/// TASK: Pool
@@ -70,13 +288,17 @@ namespace pul
 	public:
 		/// Store -> Make
 		pf_hint_nodiscard __thread_pool_storage_t *
-		__make_storage();
+		__make_storage(
+		 uint32_t __numWorkers,
+		 size_t __capacity);
 		void
 		__delete_storage(
 		 __thread_pool_storage_t *__s) pf_attr_noexcept;
 
 		/// Constructors
-		__thread_pool_t();
+		__thread_pool_t(
+		 uint32_t __numWorkers = CCY_NUM_WORKERS,
+		 size_t __capacity		 = 0);
 		__thread_pool_t(__thread_pool_t const &) = delete;
 		__thread_pool_t(__thread_pool_t &&)			 = delete;
 
@@ -91,23 +313,131 @@ namespace pul
 		operator=(
 		 __thread_pool_t &&) = delete;
 
-		/// Submit
+		/// Workers
+		pf_hint_nodiscard uint32_t
+		__num_workers() const pf_attr_noexcept;
 		void
-		__submit(
-		 __task_t *__task);
+		__resize(
+		 uint32_t __numWorkers);
+
+		/// Capacity
+		pf_hint_nodiscard size_t
+		__capacity() const pf_attr_noexcept;
+		void
+		__set_capacity(
+		 size_t __capacity);
+		pf_hint_nodiscard uint32_t
+		__num_pending() const pf_attr_noexcept;
+
+		/// Overflow
+		pf_hint_nodiscard task_overflow
+		__get_overflow() const pf_attr_noexcept;
 		void
+		__set_overflow(
+		 task_overflow __policy) pf_attr_noexcept;
+
+		/// Submit
+		bool
+		__submit(
+		 __task_t *__task,
+		 task_overflow __policy);
+		bool
+		__submit(
+		 task_priority __priority,
+		 __task_t *__task,
+		 task_overflow __policy);
+		bool
 		__submit_0(
-		 __task_t *__task);
+		 __task_t *__task,
+		 task_overflow __policy);
+		size_t
+		__submit_bulk(
+		 __task_t **__beg,
+		 __task_t **__end,
+		 task_overflow __policy);
 
 		/// Process
 		bool
 		__process();
+		bool
+		__help() pf_attr_noexcept;
+		bool
+		__help_0() pf_attr_noexcept;
 		uint32_t
 		__process_0();
+		uint32_t
+		__process_0_until(
+		 high_resolution_point_t __deadline);
+
+		/// Spin Budget
+		pf_hint_nodiscard uint32_t
+		__get_spin_budget() const pf_attr_noexcept;
+		void
+		__set_spin_budget(
+		 uint32_t __budget) pf_attr_noexcept;
+
+		/// Stats
+		pf_hint_nodiscard thread_pool_stats_t
+		__stats() const pf_attr_noexcept;
+		pf_hint_nodiscard thread_pool_stats_t
+		__worker_stats(
+		 uint32_t __index) const;
+
+		/// Affinity
+		pf_hint_nodiscard thread_affinity
+		__get_affinity() const pf_attr_noexcept;
+		bool
+		__set_affinity(
+		 thread_affinity __affinity) pf_attr_noexcept;
 
 	private:
+		/// Workers
+		pf_hint_nodiscard __thread_pool_storage_t *
+		__start(
+		 uint32_t __numWorkers);
+		void
+		__stop(
+		 __thread_pool_storage_t *__buf,
+		 __thread_pool_storage_t *__to) pf_attr_noexcept;
+		void
+		__restart(
+		 uint32_t __numWorkers);
+		pf_hint_nodiscard __thread_worker_t *
+		__local_worker(
+		 __thread_pool_storage_t *__buf) const pf_attr_noexcept;
+
+		/// Overflow
+		void
+		__wait_for_room() pf_attr_noexcept;
+
+		/// Process -> Exception
+		void
+		__run_caught(
+		 __task_t *__task) pf_attr_noexcept;
+		void
+		__rethrow_0();
+
+		/// Process -> Remaining
+		void
+		__move(
+		 __task_t *__task,
+		 __thread_pool_storage_t *__to,
+		 mpmc_lifo2<__task_t> &__lane) pf_attr_noexcept;
+		void
+		__move_0(
+		 __thread_pool_storage_t *__buf,
+		 __thread_pool_storage_t *__to) pf_attr_noexcept;
+		bool
+		__run_0(
+		 __thread_pool_storage_t *__buf) pf_attr_noexcept;
+
 		/// Store
-		__thread_pool_storage_t *buf_;
+		atomic<__thread_pool_storage_t *> buf_;	 // NOTE: Read under an epoch_guard, a restart swaps it then waits for the grace period
+		thread_affinity affinity_;
+		size_t capacity_;
+		atomic<task_overflow> overflow_;
+		mutex_t mutex_;	 // Restarts and affinity changes
+		std::exception_ptr exception0_;	 // NOTE: Main thread only, first throw of a queue0 task run while helping
 	};
 }	 // namespace pul
 
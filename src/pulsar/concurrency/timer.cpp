@@ -0,0 +1,290 @@
+/*! @file   timer.cpp
+ *  @author Louis-Quentin Noé (noe.louis-quentin@hotmail.fr)
+ *  @brief
+ *  @date   17-10-2026
+ *
+ *  @copyright Copyright (c) 2023 - Pulsar Software
+ *
+ *  @since 0.1.6
+ */
+
+// Include: Pulsar
+#include "pulsar/internal.hpp"
+
+// Pulsar
+namespace pul
+{
+	/// TIMER: Wheel
+	// Constructors
+	__timer_wheel_t::__timer_wheel_t()
+		: inbox_(nullptr)
+		, sleepUntil_(0)
+		, numPending_(0)
+		, run_(true)
+		, origin_(high_resolution_clock_t::now())
+		, current_(0)
+		, numInWheel_(0)
+	{
+		std::memset(&this->slots_[0][0], 0, sizeof(this->slots_));
+		this->thread_ = std::thread(&__timer_wheel_t::__process, this);
+	}
+
+	// Destructor
+	__timer_wheel_t::~__timer_wheel_t() pf_attr_noexcept
+	{
+		// Stop
+		{
+			lock_unique<mutex_t> lck(this->mutex_);
+			this->run_.store(false, atomic_order::relaxed);
+		}
+		this->cv_.notify_one();
+		if(this->thread_.joinable()) this->thread_.join();
+
+		// Pending -> Never fired, their tasks are discarded without running
+		__timer_node_t *n = this->inbox_.exchange(__timer_closed(), atomic_order::acq_rel);	// NOTE: Tasks still draining on the pool may schedule more
+		while(n)
+		{
+			__timer_node_t *x = n->next;
+			n->discard(n->task);
+			__task_slab_free(n);
+			n = x;
+		}
+		for(uint32_t l = 0; l != CCY_TIMER_NUM_LEVELS; ++l)
+		{
+			for(uint32_t s = 0; s != CCY_TIMER_NUM_SLOTS; ++s)
+			{
+				n = this->slots_[l][s];
+				while(n)
+				{
+					__timer_node_t *x = n->next;
+					n->discard(n->task);
+					__task_slab_free(n);
+					n = x;
+				}
+			}
+		}
+	}
+
+	// Tick
+	uint64_t
+	__timer_wheel_t::__to_tick(
+	 high_resolution_point_t __at) const pf_attr_noexcept
+	{
+		if(__at <= this->origin_) return 0;
+		const uint64_t ns = static_cast<uint64_t>(duration_cast<nanoseconds_t>(__at - this->origin_).count());
+		return (ns + CCY_TIMER_TICK - 1) / CCY_TIMER_TICK;	// NOTE: Rounded up, a timer never fires early
+	}
+	high_resolution_point_t
+	__timer_wheel_t::__to_point(
+	 uint64_t __tick) const pf_attr_noexcept
+	{
+		return this->origin_ + duration_cast<high_resolution_clock_t::duration>(nanoseconds_t(__tick * CCY_TIMER_TICK));
+	}
+
+	// Schedule
+	void
+	__timer_wheel_t::__schedule(
+	 __task_t *__task,
+	 high_resolution_point_t __at,
+	 __task_discard_fun_t __discard)
+	{
+		// Node
+		void *p = nullptr;
+		try
+		{
+			p = __task_slab_allocate(sizeof(__timer_node_t), alignof(__timer_node_t));
+		} catch(std::exception const &)
+		{
+			__discard(__task);
+			throw;
+		}
+		auto *n		 = new(p) __timer_node_t;
+		n->task		 = __task;
+		n->discard = __discard;
+		n->expiry	 = this->__to_tick(__at);
+		this->numPending_.fetch_add(1, atomic_order::relaxed);
+
+		// Inbox
+		n->next = this->inbox_.load(atomic_order::relaxed);
+		do {
+			if(n->next == __timer_closed())
+			{
+				this->numPending_.fetch_sub(1, atomic_order::relaxed);
+				__discard(__task);
+				__task_slab_free(n);
+				return;
+			}
+		} while(!this->inbox_.compare_exchange_weak(n->next, n, atomic_order::seq_cst, atomic_order::relaxed));
+
+		// Wake -> Only when the thread sleeps past this expiry
+		const uint64_t s = this->sleepUntil_.load(atomic_order::seq_cst);
+		if(s != 0 && n->expiry < s)
+		{
+			lock_unique<mutex_t> lck(this->mutex_);
+			this->cv_.notify_one();
+		}
+	}
+
+	// Pending
+	size_t
+	__timer_wheel_t::__num_pending() const pf_attr_noexcept
+	{
+		return this->numPending_.load(atomic_order::relaxed);
+	}
+
+	// Wheel -> Insert
+	void
+	__timer_wheel_t::__insert(
+	 __timer_node_t *__node) pf_attr_noexcept
+	{
+		// Already expired
+		if(__node->expiry < this->current_)
+		{
+			this->__expire(__node);
+			return;
+		}
+
+		// Level
+		uint64_t e			 = __node->expiry;
+		const uint64_t d = e - this->current_;
+		uint32_t l			 = 0;
+		while(l != CCY_TIMER_NUM_LEVELS - 1 && d >= (uint64_t(1) << (CCY_TIMER_SLOT_BITS * (l + 1)))) ++l;
+		if(d >= (uint64_t(1) << (CCY_TIMER_SLOT_BITS * CCY_TIMER_NUM_LEVELS)))
+		{
+			e = this->current_ + (uint64_t(1) << (CCY_TIMER_SLOT_BITS * CCY_TIMER_NUM_LEVELS)) - 1;	 // NOTE: Beyond the wheel, parked on the last slot and re-inserted when cascaded
+		}
+
+		// Slot
+		const uint32_t s		 = static_cast<uint32_t>((e >> (CCY_TIMER_SLOT_BITS * l)) & (CCY_TIMER_NUM_SLOTS - 1));
+		__node->next				 = this->slots_[l][s];
+		this->slots_[l][s] = __node;
+		++this->numInWheel_;
+	}
+
+	// Wheel -> Cascade
+	void
+	__timer_wheel_t::__cascade(
+	 uint32_t __level,
+	 uint32_t __slot) pf_attr_noexcept
+	{
+		__timer_node_t *n							= this->slots_[__level][__slot];
+		this->slots_[__level][__slot] = nullptr;
+		while(n)
+		{
+			__timer_node_t *x = n->next;
+			--this->numInWheel_;
+			this->__insert(n);
+			n = x;
+		}
+	}
+
+	// Wheel -> Expire
+	void
+	__timer_wheel_t::__expire(
+	 __timer_node_t *__node) pf_attr_noexcept
+	{
+		__task_t *t = __node->task;
+		__task_slab_free(__node);
+		this->numPending_.fetch_sub(1, atomic_order::relaxed);
+		__task_enqueue_continuation(t);	 // NOTE: CCY_TASK_FLAG_0 routes it to the main thread queue
+	}
+
+	// Wheel -> Advance
+	void
+	__timer_wheel_t::__advance(
+	 uint64_t __tick) pf_attr_noexcept
+	{
+		// Empty -> Jump
+		if(this->numInWheel_ == 0)
+		{
+			if(this->current_ < __tick) this->current_ = __tick;
+			return;
+		}
+
+		// Ticks
+		while(this->current_ <= __tick)
+		{
+			const uint64_t c = this->current_;
+			for(uint32_t l = 1; l != CCY_TIMER_NUM_LEVELS; ++l)
+			{
+				if((c >> (CCY_TIMER_SLOT_BITS * (l - 1))) & (CCY_TIMER_NUM_SLOTS - 1)) break;
+				this->__cascade(l, static_cast<uint32_t>((c >> (CCY_TIMER_SLOT_BITS * l)) & (CCY_TIMER_NUM_SLOTS - 1)));
+			}
+			const uint32_t s	 = static_cast<uint32_t>(c & (CCY_TIMER_NUM_SLOTS - 1));
+			__timer_node_t *n	 = this->slots_[0][s];
+			this->slots_[0][s] = nullptr;
+			while(n)
+			{
+				__timer_node_t *x = n->next;
+				--this->numInWheel_;
+				this->__expire(n);
+				n = x;
+			}
+			this->current_ = c + 1;
+		}
+	}
+
+	// Wheel -> Deadline
+	uint64_t
+	__timer_wheel_t::__next_deadline() const pf_attr_noexcept
+	{
+		if(this->numInWheel_ == 0) return ~uint64_t(0);
+		const uint64_t c = this->current_;
+		const uint64_t w = (c | (CCY_TIMER_NUM_SLOTS - 1)) + 1;	// Next cascade
+		for(uint64_t t = c; t != w; ++t)
+		{
+			if(this->slots_[0][t & (CCY_TIMER_NUM_SLOTS - 1)]) return t;
+		}
+		return w;
+	}
+
+	// Thread
+	void
+	__timer_wheel_t::__process() pf_attr_noexcept
+	{
+		while(this->run_.load(atomic_order::relaxed))
+		{
+			// Inbox
+			__timer_node_t *n = this->inbox_.exchange(nullptr, atomic_order::acquire);
+			while(n)
+			{
+				__timer_node_t *x = n->next;
+				this->__insert(n);
+				n = x;
+			}
+
+			// Expire
+			const uint64_t ns = static_cast<uint64_t>(duration_cast<nanoseconds_t>(high_resolution_clock_t::now() - this->origin_).count());
+			this->__advance(ns / CCY_TIMER_TICK);	 // NOTE: Rounded down, expiries are rounded up
+
+			// Sleep
+			const uint64_t d = this->__next_deadline();
+			this->sleepUntil_.store(d, atomic_order::seq_cst);	// NOTE: Pairs with __schedule
+			{
+				lock_unique<mutex_t> lck(this->mutex_);
+				auto p = [this]()
+				{ return this->inbox_.load(atomic_order::seq_cst) != nullptr || !this->run_.load(atomic_order::relaxed); };
+				if(d == ~uint64_t(0))
+					this->cv_.wait(lck, p);
+				else
+					this->cv_.wait_until(lck, this->__to_point(d), p);
+			}
+			this->sleepUntil_.store(0, atomic_order::relaxed);
+		}
+	}
+
+	/// CONCURRENCY: Task -> Timer
+	pulsar_api void
+	__timer_schedule(
+	 __task_t *__task,
+	 high_resolution_point_t __at,
+	 __task_discard_fun_t __discard)
+	{
+		__internal.timer.__schedule(__task, __at, __discard);
+	}
+	pulsar_api size_t
+	timer_num_pending() pf_attr_noexcept
+	{
+		return __internal.timer.__num_pending();
+	}
+}	 // namespace pul
@@ -0,0 +1,123 @@
+/*! @file   timer.hpp
+ *  @author Louis-Quentin Noé (noe.louis-quentin@hotmail.fr)
+ *  @brief
+ *  @date   17-10-2026
+ *
+ *  @copyright Copyright (c) 2023 - Pulsar Software
+ *
+ *  @since 0.1.6
+ */
+
+#ifndef PULSAR_SRC_TIMER_HPP
+#define PULSAR_SRC_TIMER_HPP 1
+
+// Include: Pulsar
+#include "pulsar/pulsar.hpp"
+#include "pulsar/chrono.hpp"
+#include "pulsar/concurrency.hpp"
+#include "pulsar/thread_pool.hpp"
+
+// Pulsar
+namespace pul
+{
+	/// TIMER: Constants
+	pf_decl_constexpr uint32_t CCY_TIMER_NUM_LEVELS = 4;
+	pf_decl_constexpr uint32_t CCY_TIMER_SLOT_BITS	= 8;
+	pf_decl_constexpr uint32_t CCY_TIMER_NUM_SLOTS	= 1 << CCY_TIMER_SLOT_BITS;
+	pf_decl_constexpr uint64_t CCY_TIMER_TICK				= 1'000'000;	// NOTE: Resolution in nanoseconds
+
+	/// TIMER: Node
+	struct __timer_node_t
+	{
+		__timer_node_t *next;
+		__task_t *task;
+		__task_discard_fun_t discard;	 // Frees the task if it never fires
+		uint64_t expiry;							 // Tick
+	};
+	pf_hint_nodiscard pf_decl_inline __timer_node_t *
+	__timer_closed() pf_attr_noexcept
+	{
+		return union_cast<__timer_node_t *>(size_t(1));	 // NOTE: Marks the inbox of a stopped wheel, later timers are discarded
+	}
+
+	/// TIMER: Wheel
+	/*! @brief Hierarchical timing wheel, CCY_TIMER_NUM_LEVELS levels of CCY_TIMER_NUM_SLOTS slots.
+	 *				 Timers are pushed on a lock-free inbox, a dedicated thread inserts them in O(1), cascades
+	 *				 upper levels when a lower one wraps and enqueues expired tasks on the pool.
+	 */
+	class __timer_wheel_t
+	{
+	public:
+		/// Constructors
+		__timer_wheel_t();
+		__timer_wheel_t(__timer_wheel_t const &) = delete;
+		__timer_wheel_t(__timer_wheel_t &&)			 = delete;
+
+		/// Destructor
+		~__timer_wheel_t() pf_attr_noexcept;
+
+		/// Operator =
+		__timer_wheel_t &
+		operator=(
+		 __timer_wheel_t const &) = delete;
+		__timer_wheel_t &
+		operator=(
+		 __timer_wheel_t &&) = delete;
+
+		/// Schedule
+		void
+		__schedule(
+		 __task_t *__task,
+		 high_resolution_point_t __at,
+		 __task_discard_fun_t __discard);
+
+		/// Pending
+		pf_hint_nodiscard size_t
+		__num_pending() const pf_attr_noexcept;
+
+	private:
+		/// Tick
+		pf_hint_nodiscard uint64_t
+		__to_tick(
+		 high_resolution_point_t __at) const pf_attr_noexcept;
+		pf_hint_nodiscard high_resolution_point_t
+		__to_point(
+		 uint64_t __tick) const pf_attr_noexcept;
+
+		/// Wheel
+		void
+		__insert(
+		 __timer_node_t *__node) pf_attr_noexcept;
+		void
+		__cascade(
+		 uint32_t __level,
+		 uint32_t __slot) pf_attr_noexcept;
+		void
+		__expire(
+		 __timer_node_t *__node) pf_attr_noexcept;
+		void
+		__advance(
+		 uint64_t __tick) pf_attr_noexcept;
+		pf_hint_nodiscard uint64_t
+		__next_deadline() const pf_attr_noexcept;
+
+		/// Thread
+		void
+		__process() pf_attr_noexcept;
+
+		/// Store
+		pf_alignas(CCY_ALIGN) atomic<__timer_node_t *> inbox_;
+		pf_alignas(CCY_ALIGN) atomic<uint64_t> sleepUntil_;	 // NOTE: Tick the thread sleeps until, 0 when awake
+		atomic<size_t> numPending_;
+		atomic<bool> run_;
+		mutex_t mutex_;
+		condition_variable_t cv_;
+		const high_resolution_point_t origin_;
+		uint64_t current_;	// First tick not processed yet
+		size_t numInWheel_;
+		__timer_node_t *slots_[CCY_TIMER_NUM_LEVELS][CCY_TIMER_NUM_SLOTS];
+		std::thread thread_;
+	};
+}	 // namespace pul
+
+#endif	// !PULSAR_SRC_TIMER_HPP
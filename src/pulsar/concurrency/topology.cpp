@@ -0,0 +1,153 @@
+/*! @file   topology.cpp
+ *  @author Louis-Quentin Noé (noe.louis-quentin@hotmail.fr)
+ *  @brief
+ *  @date   17-10-2026
+ *
+ *  @copyright Copyright (c) 2023 - Pulsar Software
+ *
+ *  @since 0.1.6
+ */
+
+// Include: Pulsar
+#include "pulsar/internal.hpp"
+
+// Include: C++
+#include <cstdio>
+#include <cstdlib>
+
+// Pulsar
+namespace pul
+{
+	/// TOPOLOGY: Type
+	__cpu_topology_t::__cpu_topology_t() pf_attr_noexcept
+		: numCpus(0)
+		, numCores(0)
+		, numCaches(0)
+		, quota(0)
+	{
+#ifdef PF_OS_LINUX
+		__cpu_topology_discover_lin(this);
+#endif	// PF_OS_LINUX
+
+		// Fallback
+		if(this->numCpus == 0)
+		{
+			uint32_t n = std::thread::hardware_concurrency();
+			if(n == 0) n = 1;
+			if(n > CCY_TOPOLOGY_MAX_CPUS) n = CCY_TOPOLOGY_MAX_CPUS;
+			for(uint32_t i = 0; i != n; ++i) this->cpus[i] = { i, i, 0, 0 };
+			this->numCpus		= n;
+			this->numCores	= n;
+			this->numCaches = 1;
+		}
+	}
+
+	/// TOPOLOGY: Usable
+	uint32_t
+	__cpu_topology_t::__num_usable() const pf_attr_noexcept
+	{
+		uint32_t n = this->numCpus;
+		if(this->quota != 0 && this->quota < n) n = this->quota;
+		return n;
+	}
+
+	/// TOPOLOGY: Get
+	__cpu_topology_t const &
+	__cpu_topology() pf_attr_noexcept
+	{
+		pf_decl_static __cpu_topology_t topology;	 // NOTE: Read before __internal is built, by CCY_NUM_THREADS
+		return topology;
+	}
+
+	/// TOPOLOGY: Affinity
+	bool
+	__thread_set_affinity(
+	 std::thread &__thread,
+	 thread_affinity __affinity,
+	 uint32_t __index) pf_attr_noexcept
+	{
+#ifdef PF_OS_LINUX
+		return __thread_set_affinity_lin(__thread, __cpu_topology(), __affinity, __index);
+#else		// ^^^ PF_OS_LINUX ^^^ / vvv !PF_OS_LINUX vvv
+		(void)__thread;
+		(void)__index;
+		return __affinity == thread_affinity::none;
+#endif	// !PF_OS_LINUX
+	}
+
+	/// CONCURRENCY: Hardware Concurrency
+	pulsar_api uint32_t
+	__ccy_hardware_concurrency() pf_attr_noexcept
+	{
+		const uint32_t n = __cpu_topology().__num_usable();
+		return n < 2 ? 2 : n;
+	}
+
+	/// CONCURRENCY: Thread Indices
+	pf_decl_static atomic<uint64_t> __idx_bits[(2 * CCY_TOPOLOGY_MAX_CPUS + 64) / 64];	 // NOTE: Constant initialised, get_idx may run before __internal
+	pf_decl_static atomic<uint32_t> __idx_live = 0;
+
+	namespace this_thread
+	{
+		pulsar_api thread_id_t
+		__idx_acquire() pf_attr_noexcept
+		{
+			const uint32_t m = 2 * __ccy_hardware_concurrency() + 64;	// NOTE: CCY_MAX_THREADS, which may not be built yet
+			for(uint32_t i = 0; i != m; ++i)
+			{
+				const uint64_t b = 1ull << (i & 63);
+				if((__idx_bits[i >> 6].load(atomic_order::relaxed) & b) == 0
+						&& (__idx_bits[i >> 6].fetch_or(b, atomic_order::acq_rel) & b) == 0)
+				{
+					__idx_live.fetch_add(1, atomic_order::relaxed);
+					return i;
+				}
+			}
+			std::fputs("pulsar: more than CCY_MAX_THREADS live threads, this_thread::get_idx() ran out of indices!\n", stderr);	// NOTE: Not through dbg, which calls get_idx
+			std::abort();
+		}
+		pulsar_api void
+		__idx_release(
+		 thread_id_t __idx) pf_attr_noexcept
+		{
+			if(__idx == 0) return;	// NOTE: The main thread's, kept until the end as statics may still use it
+			__idx_live.fetch_sub(1, atomic_order::relaxed);
+			__idx_bits[__idx >> 6].fetch_and(~(1ull << (__idx & 63)), atomic_order::release);
+		}
+		pulsar_api uint32_t
+		__idx_num_live() pf_attr_noexcept
+		{
+			return __idx_live.load(atomic_order::relaxed);
+		}
+	}	 // namespace this_thread
+
+	/// CONCURRENCY: Topology
+	pulsar_api uint32_t
+	cpu_topology_num_cpus() pf_attr_noexcept
+	{
+		return __cpu_topology().numCpus;
+	}
+	pulsar_api uint32_t
+	cpu_topology_num_cores() pf_attr_noexcept
+	{
+		return __cpu_topology().numCores;
+	}
+	pulsar_api uint32_t
+	cpu_topology_num_caches() pf_attr_noexcept
+	{
+		return __cpu_topology().numCaches;
+	}
+	pulsar_api uint32_t
+	cpu_topology_quota() pf_attr_noexcept
+	{
+		return __cpu_topology().quota;
+	}
+	pulsar_api cpu_info_t
+	cpu_topology_get(
+	 uint32_t __index) pf_attr_noexcept
+	{
+		__cpu_topology_t const &t = __cpu_topology();
+		pf_assert(__index < t.numCpus, "__index is out of range. __index={}, numCpus={}", __index, t.numCpus);
+		return t.cpus[__index];
+	}
+}	 // namespace pul
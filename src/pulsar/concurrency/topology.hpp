@@ -0,0 +1,81 @@
+/*! @file   topology.hpp
+ *  @author Louis-Quentin Noé (noe.louis-quentin@hotmail.fr)
+ *  @brief
+ *  @date   17-10-2026
+ *
+ *  @copyright Copyright (c) 2023 - Pulsar Software
+ *
+ *  @since 0.1.6
+ */
+
+#ifndef PULSAR_SRC_TOPOLOGY_HPP
+#define PULSAR_SRC_TOPOLOGY_HPP 1
+
+// Include: Pulsar
+#include "pulsar/pulsar.hpp"
+#include "pulsar/concurrency.hpp"
+#include "pulsar/thread_pool.hpp"
+
+// Pulsar
+namespace pul
+{
+	/// TOPOLOGY: Constants
+	pf_decl_constexpr uint32_t CCY_TOPOLOGY_MAX_CPUS = 1'024;
+
+	/// TOPOLOGY: Type
+	struct __cpu_topology_t
+	{
+		/// Constructors
+		__cpu_topology_t() pf_attr_noexcept;
+		__cpu_topology_t(__cpu_topology_t const &) = delete;
+		__cpu_topology_t(__cpu_topology_t &&)			 = delete;
+
+		/// Destructor
+		~__cpu_topology_t() pf_attr_noexcept = default;
+
+		/// Operator =
+		__cpu_topology_t &
+		operator=(
+		 __cpu_topology_t const &) = delete;
+		__cpu_topology_t &
+		operator=(
+		 __cpu_topology_t &&) = delete;
+
+		/// Usable
+		pf_hint_nodiscard uint32_t
+		__num_usable() const pf_attr_noexcept;
+
+		/// Store
+		cpu_info_t cpus[CCY_TOPOLOGY_MAX_CPUS];	 // Allowed CPUs, sorted by id
+		uint32_t numCpus;
+		uint32_t numCores;
+		uint32_t numCaches;
+		uint32_t quota;
+	};
+
+	/// TOPOLOGY: Get
+	pf_hint_nodiscard __cpu_topology_t const &
+	__cpu_topology() pf_attr_noexcept;
+
+	/// TOPOLOGY: Affinity
+	bool
+	__thread_set_affinity(
+	 std::thread &__thread,
+	 thread_affinity __affinity,
+	 uint32_t __index) pf_attr_noexcept;
+
+	/// TOPOLOGY: Linux
+#ifdef PF_OS_LINUX
+	void
+	__cpu_topology_discover_lin(
+	 __cpu_topology_t *__topology) pf_attr_noexcept;
+	bool
+	__thread_set_affinity_lin(
+	 std::thread &__thread,
+	 __cpu_topology_t const &__topology,
+	 thread_affinity __affinity,
+	 uint32_t __index) pf_attr_noexcept;
+#endif	// PF_OS_LINUX
+}	 // namespace pul
+
+#endif	// !PULSAR_SRC_TOPOLOGY_HPP
@@ -0,0 +1,170 @@
+/*! @file   topology_lin.cpp
+ *  @author Louis-Quentin Noé (noe.louis-quentin@hotmail.fr)
+ *  @brief
+ *  @date   17-10-2026
+ *
+ *  @copyright Copyright (c) 2023 - Pulsar Software
+ *
+ *  @since 0.1.6
+ */
+
+// Include: Pulsar
+#include "pulsar/internal.hpp"
+
+// Linux
+#ifdef PF_OS_LINUX
+ #include <sched.h>
+ #include <pthread.h>
+
+ // Include: C
+ #include <cstdio>
+ #include <cstdlib>
+
+// Pulsar
+namespace pul
+{
+	/// TOPOLOGY: Linux -> Read
+	pf_hint_nodiscard pf_decl_static bool
+	__sys_read_uint(
+	 const char *__path,
+	 uint32_t *__val) pf_attr_noexcept
+	{
+		std::FILE *f = std::fopen(__path, "r");
+		if(!f) return false;
+		const bool r = std::fscanf(f, "%u", __val) == 1;
+		std::fclose(f);
+		return r;
+	}
+
+	/// TOPOLOGY: Linux -> Quota
+	pf_hint_nodiscard pf_decl_static uint32_t
+	__sys_read_quota() pf_attr_noexcept
+	{
+		// cgroup v2
+		char q[32]								= { '\0' };
+		unsigned long long period = 0;
+		std::FILE *f							= std::fopen("/sys/fs/cgroup/cpu.max", "r");
+		if(f)
+		{
+			const int32_t n = std::fscanf(f, "%31s %llu", q, &period);
+			std::fclose(f);
+			if(n != 2 || period == 0 || q[0] == 'm') return 0;	// NOTE: "max" is unlimited
+			const unsigned long long quota = std::strtoull(q, nullptr, 10);
+			return static_cast<uint32_t>((quota + period - 1) / period);
+		}
+
+		// cgroup v1
+		long long quota = -1;
+		f								= std::fopen("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", "r");
+		if(!f) return 0;
+		const bool r = std::fscanf(f, "%lld", &quota) == 1;
+		std::fclose(f);
+		f = std::fopen("/sys/fs/cgroup/cpu/cpu.cfs_period_us", "r");
+		if(!f) return 0;
+		const bool p = std::fscanf(f, "%llu", &period) == 1;
+		std::fclose(f);
+		if(!r || !p || quota <= 0 || period == 0) return 0;
+		return static_cast<uint32_t>((static_cast<unsigned long long>(quota) + period - 1) / period);
+	}
+
+	/// TOPOLOGY: Linux -> Dense
+	pf_hint_nodiscard pf_decl_static uint32_t
+	__sys_dense_index(
+	 uint64_t *__keys,
+	 uint32_t *__num,
+	 uint64_t __key) pf_attr_noexcept
+	{
+		for(uint32_t i = 0; i != *__num; ++i)
+		{
+			if(__keys[i] == __key) return i;
+		}
+		__keys[*__num] = __key;
+		return (*__num)++;
+	}
+
+	/// TOPOLOGY: Linux -> Discover
+	void
+	__cpu_topology_discover_lin(
+	 __cpu_topology_t *__topology) pf_attr_noexcept
+	{
+		// Affinity
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if(sched_getaffinity(0, sizeof(set), &set) != 0) return;
+
+		// CPUs
+		uint64_t cores[CCY_TOPOLOGY_MAX_CPUS];
+		uint64_t caches[CCY_TOPOLOGY_MAX_CPUS];
+		char path[128] = { '\0' };
+		for(uint32_t id = 0; id != CPU_SETSIZE && id != CCY_TOPOLOGY_MAX_CPUS; ++id)
+		{
+			if(!CPU_ISSET(id, &set)) continue;
+
+			// Physical core
+			uint32_t package = 0, core = id;
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", id);
+			(void)__sys_read_uint(path, &package);
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", id);
+			(void)__sys_read_uint(path, &core);
+
+			// L3
+			uint32_t cache = package;
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index3/id", id);
+			const bool l3 = __sys_read_uint(path, &cache);
+
+			cpu_info_t &c = __topology->cpus[__topology->numCpus++];
+			c.id					= id;
+			c.package			= package;
+			c.core				= __sys_dense_index(cores, &__topology->numCores, (uint64_t(package) << 32) | core);
+			c.cache				= __sys_dense_index(caches, &__topology->numCaches, (uint64_t(l3 ? 1 : 0) << 63) | (uint64_t(package) << 32) | cache);	// NOTE: Without index3, a package is a domain
+		}
+
+		// Quota
+		__topology->quota = __sys_read_quota();
+	}
+
+	/// TOPOLOGY: Linux -> Affinity
+	bool
+	__thread_set_affinity_lin(
+	 std::thread &__thread,
+	 __cpu_topology_t const &__topology,
+	 thread_affinity __affinity,
+	 uint32_t __index) pf_attr_noexcept
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		switch(__affinity)
+		{
+			case thread_affinity::physical_core:
+			{
+				const uint32_t k = (__index + 1) % __topology.numCores;	// NOTE: Core 0 is left to the main thread
+				for(uint32_t i = 0; i != __topology.numCpus; ++i)
+				{
+					if(__topology.cpus[i].core == k)
+					{
+						CPU_SET(__topology.cpus[i].id, &set);
+						break;
+					}
+				}
+				break;
+			}
+			case thread_affinity::cache_domain:
+			{
+				const uint32_t k = ((__index + 1) * __topology.numCaches / CCY_NUM_THREADS) % __topology.numCaches;
+				for(uint32_t i = 0; i != __topology.numCpus; ++i)
+				{
+					if(__topology.cpus[i].cache == k) CPU_SET(__topology.cpus[i].id, &set);
+				}
+				break;
+			}
+			default:
+			{
+				for(uint32_t i = 0; i != __topology.numCpus; ++i) CPU_SET(__topology.cpus[i].id, &set);
+				break;
+			}
+		}
+		return pthread_setaffinity_np(__thread.native_handle(), sizeof(set), &set) == 0;
+	}
+}	 // namespace pul
+
+#endif	// PF_OS_LINUX
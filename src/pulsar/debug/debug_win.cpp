@@ -214,7 +214,7 @@ namespace pul
 
 	/// Constructors
 	__dbg_internal_t::__dbg_internal_t() pf_attr_noexcept
-		: buffer_(new_construct<__dbg_record_win_t[]>(CCY_NUM_THREADS))
+		: buffer_(new_construct<__dbg_record_win_t[]>(CCY_MAX_THREADS))
 	{
 		this->handle_ = AddVectoredExceptionHandler(0, __vectored_exception_handler);
 		pf_assert(this->handle_, "[WIN] AddVectoredExceptionHandler for printing stacktrace failed! handle={}", this->handle_);
@@ -535,7 +535,7 @@ namespace pul
 	 atomic<bool> *__ctrl)
 	{
 		// Update local thread EXCEPTION_POINTERS + ID of thread thrower
-		__dbg_set_current_exception_record(__record);
+		if(__record) __dbg_set_current_exception_record(__record);
 
 		// Rethrow exception. Since it's thrown inside a try - catch block, it'll
 		// be destroyed only if it exit it, unblocking the throwing thread.
@@ -555,6 +555,12 @@ namespace pul
 		{
 			auto p		 = std::move(this->ptr_);
 			this->ptr_ = nullptr;
+			if(!this->ctrl_ && this->record_)
+			{
+				__dbg_set_current_exception_record(this->record_);
+				__dbg_delete_exception_record(this->record_);
+				this->record_ = nullptr;
+			}
 			__dbg_exception_record_switch_task_win(std::move(p), this->record_, this->ctrl_);
 		}
 	}
@@ -566,14 +572,45 @@ namespace pul
 		auto *ctx = __internal.dbg_internal.__retrieve_current_context();
 		return ctx;
 	}
+	pf_decl_static void
+	__dbg_copy_exception_record_win(
+	 __dbg_record_win_t *__dst,
+	 __dbg_record_win_t const *__src) pf_attr_noexcept
+	{
+		if(__dst == __src) return;
+		__dst->ID = __src->ID;
+		if(!__src->exp || !__src->exp->ExceptionRecord || !__src->exp->ContextRecord)
+		{
+			__dst->exp = nullptr;
+			return;
+		}
+		__dst->exceptionCopy									= *__src->exp->ExceptionRecord;
+		__dst->exceptionCopy.ExceptionRecord	= nullptr;	// NOTE: Chained records aren't kept
+		__dst->contextCopy										= *__src->exp->ContextRecord;
+		__dst->expCopy.ExceptionRecord				= &__dst->exceptionCopy;
+		__dst->expCopy.ContextRecord					= &__dst->contextCopy;
+		__dst->exp														= &__dst->expCopy;
+	}
+	void *
+	__dbg_copy_current_exception_record() pf_attr_noexcept
+	{
+		auto *r = new_construct<__dbg_record_win_t>();
+		__dbg_copy_exception_record_win(r, __internal.dbg_internal.__retrieve_current_context());
+		return r;
+	}
+	void
+	__dbg_delete_exception_record(
+	 void *__record) pf_attr_noexcept
+	{
+		destroy_delete(union_cast<__dbg_record_win_t *>(__record));
+	}
 	void
 	__dbg_set_current_exception_record(
 	 void *__record) pf_attr_noexcept
 	{
 		__dbg_record_win_t *r	 = __internal.dbg_internal.__retrieve_current_context();
 		__dbg_record_win_t *in = union_cast<__dbg_record_win_t *>(__record);
-		r->exp								 = in->exp;
-		r->ID									 = in->ID;
+		__dbg_copy_exception_record_win(r, in);
 	}
 
 	/// DEBUG: Record -> Switcher
@@ -312,6 +312,11 @@ namespace pul
 	{
 		EXCEPTION_POINTERS *exp = nullptr;
 		thread_id_t ID					= 0;
+
+		// NOTE: Owned copy of *exp, filled when a record outlives the catch block of its thrower
+		EXCEPTION_POINTERS expCopy		 = {};
+		EXCEPTION_RECORD exceptionCopy = {};
+		CONTEXT contextCopy						 = {};
 	};
 	struct __dbg_internal_t
 	{
@@ -32,7 +32,10 @@
 #include "pulsar/debug/debug.hpp"
 
 // Include: Pulsar -> Src -> Thread Pool
+#include "pulsar/concurrency/topology.hpp"
 #include "pulsar/concurrency/thread_pool.hpp"
+#include "pulsar/concurrency/timer.hpp"
+#include "pulsar/concurrency/reclamation.hpp"
 
 // Pulsar
 namespace pul
@@ -63,9 +66,18 @@ namespace pul
 		__dbg_internal_t dbg_internal;
 		__dbg_logger_t dbg_logger;
 
+		/// Module -> Reclamation
+		__reclaim_domain_t reclaim;	 // NOTE: Outlives the pool, its workers release their records when they exit
+
+		/// Module -> Task Slab
+		__task_slab_t task_slab;	// NOTE: Outlives the pool, its workers free tasks until they join
+
 		/// Module -> Thread Pool
 		__thread_pool_t thread_pool;
 
+		/// Module -> Timer
+		__timer_wheel_t timer;	// NOTE: Stopped before the pool, it enqueues on it. Timers the draining pool schedules are discarded
+
 		/// Module -> IO Async Controller
 		task_pool_t io_async_controller;
 	};
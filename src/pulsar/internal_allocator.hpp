@@ -172,14 +172,14 @@ namespace pul
 		 size_t __seqsize0,
 		 size_t __seqsize)
 		{
-			this->buffer_ = union_cast<byte_t *>(halloc((sizeof(__buffer_t) - 1) * (CCY_NUM_WORKERS * __seqsize + __seqsize0), align_val_t(32), sizeof(__buffer_t)));
+			this->buffer_ = union_cast<byte_t *>(halloc((sizeof(__buffer_t) + __seqsize0) + (sizeof(__buffer_t) + __seqsize) * (CCY_MAX_THREADS - 1), align_val_t(32), sizeof(__buffer_t)));	 // NOTE: One per get_idx index, see __get_buffer
 			pf_throw_if(
 			 !this->buffer_,
 			 dbg_category_generic(),
 			 dbg_code::runtime_error,
 			 dbg_flags::dump_with_handle_data,
 			 "Failed to create new heap buffer!");
-			for(size_t i = 0; i < CCY_NUM_THREADS; ++i)
+			for(size_t i = 0; i < CCY_MAX_THREADS; ++i)
 			{
 				construct(this->__get_buffer(i));
 			}
@@ -196,7 +196,7 @@ namespace pul
 				__buffer_t *as_buffer;
 			};
 			as_byte = __buffer;
-			for(size_t i = 0; i < CCY_NUM_THREADS; ++i)
+			for(size_t i = 0; i < CCY_MAX_THREADS; ++i)
 			{
 				destroy(this->__get_buffer(i));
 			}
@@ -597,9 +597,9 @@ namespace pul
 			, start_(__start)
 			, magnifier_(std::move(__magnifier))
 		{
-			this->ctrls_ = union_cast<__controller_t *>(halloc(sizeof(__controller_t) * CCY_NUM_THREADS, ALIGN_DEFAULT, 0));
+			this->ctrls_ = union_cast<__controller_t *>(halloc(sizeof(__controller_t) * CCY_MAX_THREADS, ALIGN_DEFAULT, 0));	// NOTE: One per get_idx index
 			construct(&this->ctrls_[0], 0, this->start0_);
-			for(uint32_t i = 1; i < CCY_NUM_THREADS; ++i)
+			for(uint32_t i = 1; i < CCY_MAX_THREADS; ++i)
 			{
 				construct(&this->ctrls_[i], i, this->start_);
 			}
@@ -610,7 +610,7 @@ namespace pul
 		/// Destructor
 		pf_decl_inline ~allocator_mamd_stack_buffer() pf_attr_noexcept
 		{
-			for(uint32_t i = 0; i < CCY_NUM_THREADS; ++i)
+			for(uint32_t i = 0; i < CCY_MAX_THREADS; ++i)
 			{
 				destroy(&this->ctrls_[i]);
 			}
@@ -12,6 +12,7 @@
 #include "pulsar/pulsar.hpp"
 #include "pulsar/allocator.hpp"
 #include "pulsar/iterable.hpp"
+#include "pulsar/concurrency.hpp"
 
 // Include: Pulsar -> Tester
 #include "pulsar_tester/pulsar_tester.hpp"
@@ -43,6 +44,31 @@ namespace pul
 				return this_thread::get_idx();
 			});
 		}
+		pt_unit(idx_unique_unit)
+		{
+			const thread_id_t m = this_thread::get_idx();
+			thread_id_t ids[8];
+			atomic<uint32_t> ready = 0;
+			std::thread w[8];
+			for(uint32_t t = 0; t != 8; ++t)
+			{
+				w[t] = std::thread(
+				 [&, t]()
+				 {
+					 ids[t] = this_thread::get_idx();
+					 ready.fetch_add(1, atomic_order::acq_rel);
+					 while(ready.load(atomic_order::acquire) != 8) this_thread::yield();	// NOTE: All alive at once
+				 });
+			}
+			for(auto &x: w) x.join();
+			bool u = true;
+			for(uint32_t i = 0; i != 8; ++i)
+			{
+				u &= ids[i] != m && ids[i] < CCY_MAX_THREADS;
+				for(uint32_t j = 0; j != i; ++j) u &= ids[i] != ids[j];
+			}
+			pt_check(u);
+		}
 	}
 
 	// MPMC Ring Allocator
@@ -69,6 +95,308 @@ namespace pul
 		}
 	}
 
+	// MPMC Ring
+	pt_pack(mpmc_ring_pack)
+	{
+		pt_unit(fifo_full_bulk_unit)
+		{
+			mpmc_ring<size_t> queue(1'024);
+			size_t buf[1'024] = { 0 };
+			for(size_t i = 0; i < 1'024; ++i)
+			{
+				buf[i] = i;
+				pt_check(queue.try_enqueue(&buf[i]));
+			}
+			pt_check(!queue.try_enqueue(&buf[0]));
+			pt_check(queue.size() == 1'024);
+			pt_check(queue.try_dequeue() == &buf[0]);	 // FIFO
+			pt_check(queue.try_dequeue() == &buf[1]);
+
+			size_t *out[256] = { nullptr };
+			pt_check(queue.try_dequeue_bulk(&out[0], &out[0] + 256) == 256);
+			pt_check(out[0] == &buf[2] && out[255] == &buf[257]);
+			pt_check(queue.try_enqueue_bulk(&out[0], &out[0] + 256) == 256);	// Wraps around
+			pt_check(queue.try_enqueue_bulk(&out[0], &out[0] + 256) == 2);
+			while(queue.try_dequeue_bulk(&out[0], &out[0] + 256) != 0)
+				;
+			pt_check(queue.empty());
+			pt_check(queue.try_dequeue() == nullptr);
+		}
+		pt_benchmark(ring_pop_t1, __bvn, 16'192, 1)
+		{
+			mpmc_ring<size_t> queue(16'384 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				ignore = queue.try_enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(ring_push_t1, __bvn, 16'192, 1)
+		{
+			mpmc_ring<size_t> queue(16'384 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = queue.try_enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(ring_pop_t8, __bvn, 16'192, 8)
+		{
+			mpmc_ring<size_t> queue(16'384 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				ignore = queue.try_enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(ring_push_t8, __bvn, 16'192, 8)
+		{
+			mpmc_ring<size_t> queue(16'384 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = queue.try_enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(ring_pop_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			mpmc_ring<size_t> queue(16'384 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				ignore = queue.try_enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(ring_push_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			mpmc_ring<size_t> queue(16'384 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = queue.try_enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
+	}
+
+	// SPSC Ring
+	pt_pack(spsc_ring_pack)
+	{
+		pt_unit(push_pop_window_unit)
+		{
+			spsc_ring<uint32_t> ring(64);
+			for(uint32_t i = 0; i != 64; ++i) pt_check(ring.try_push(i));
+			pt_check(!ring.try_push(64u));
+			uint32_t v = 0;
+			pt_check(ring.try_pop(v) && v == 0);	// FIFO
+
+			uint32_t buf[48] = { 0 };
+			pt_check(ring.try_pop_n(&buf[0], 48) == 48);
+			pt_check(buf[0] == 1 && buf[47] == 48);
+			pt_check(ring.try_push_n(&buf[0], 48) == 48);
+			pt_check(ring.size() == 63);
+
+			// Windows stop at the end of the buffer
+			while(ring.try_pop(v))
+				;
+			auto w = ring.reserve(64);
+			pt_check(w.count == 16);	// Tail at 48 (112 pushed), 64 - 48 contiguous slots
+			for(size_t i = 0; i != w.count; ++i) w.data[i] = static_cast<uint32_t>(i);
+			ring.commit(w.count);
+			auto r = ring.peek(64);
+			pt_check(r.count == 16 && r.data[15] == 15);
+			ring.consume(r.count);
+			pt_check(ring.empty());
+		}
+		pt_unit(stream_unit)
+		{
+			const uint64_t n = 1'000'000;
+			spsc_ring<uint64_t> ring(1'024);
+			pf_alignas(CCY_ALIGN) atomic<uint64_t> sum = 0;
+			pf_alignas(CCY_ALIGN) atomic<bool> ordered = true;
+			std::thread c(
+			 [&]()
+			 {
+				 uint64_t b[64], e = 0, s = 0;
+				 while(e != n)
+				 {
+					 const size_t k = ring.try_pop_n(&b[0], 64);
+					 for(size_t i = 0; i != k; ++i)
+					 {
+						 if(b[i] != e++) ordered.store(false, atomic_order::relaxed);
+						 s += b[i];
+					 }
+				 }
+				 sum.store(s, atomic_order::relaxed);
+			 });
+			for(uint64_t i = 0; i != n;)
+			{
+				if(ring.try_push(i)) ++i;
+			}
+			c.join();
+			pt_check(ordered.load(atomic_order::relaxed));
+			pt_check(sum.load(atomic_order::relaxed) == n * (n - 1) / 2);
+		}
+	}
+
+	// MPMC Segmented
+	pt_pack(mpmc_segmented_fifo_pack)
+	{
+		pt_unit(burst_unit)
+		{
+			const size_t n = 16 * mpmc_segmented_fifo<size_t>::SEGMENT_SIZE;
+			mpmc_segmented_fifo<size_t> queue(4);
+			size_t *buf = new_construct<size_t[]>(n);
+			for(size_t r = 0; r != 3; ++r)
+			{
+				for(size_t i = 0; i != n; ++i)
+				{
+					buf[i] = i;
+					queue.enqueue(&buf[i]);
+				}
+				pt_check(queue.num_segments() >= 16);	// Grows with the burst
+				bool fifo = true;
+				for(size_t i = 0; i != n; ++i) fifo &= queue.try_dequeue() == &buf[i];
+				pt_check(fifo);
+				pt_check(queue.empty());
+				pt_check(queue.try_dequeue() == nullptr);
+				pt_check(queue.num_segments() <= 4 + 2);	// Shrinks back to the pool
+			}
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(segmented_pop_t1, __bvn, 16'192, 1)
+		{
+			mpmc_segmented_fifo<size_t> queue;
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				queue.enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(segmented_push_t1, __bvn, 16'192, 1)
+		{
+			mpmc_segmented_fifo<size_t> queue;
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				queue.enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(segmented_pop_t8, __bvn, 16'192, 8)
+		{
+			mpmc_segmented_fifo<size_t> queue;
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				queue.enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(segmented_push_t8, __bvn, 16'192, 8)
+		{
+			mpmc_segmented_fifo<size_t> queue;
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				queue.enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(segmented_pop_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			mpmc_segmented_fifo<size_t> queue;
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				queue.enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(segmented_push_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			mpmc_segmented_fifo<size_t> queue;
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				queue.enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
+	}
+
 	// MPMC Queue2
 	pt_pack(mpmc_lifo2_pack)
 	{
@@ -103,6 +431,68 @@ namespace pul
 				return __index; });
 			destroy_delete<size_t[]>(buf);
 		}
+		pt_benchmark(pop2_t1, __bvn, 16'192, 1)
+		{
+			mpmc_lifo2<size_t> queue(16'192 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				queue.try_enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(push2_t1, __bvn, 16'192, 1)
+		{
+			mpmc_lifo2<size_t> queue(16'192 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				queue.try_enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(pop2_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			mpmc_lifo2<size_t> queue(16'192 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				queue.try_enqueue(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return queue.try_dequeue(); });
+			destroy_delete<size_t[]>(buf);
+		}
+		pt_benchmark(push2_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			mpmc_lifo2<size_t> queue(16'192 * 128);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				queue.try_enqueue(&buf[__index]);
+				return __index; });
+			destroy_delete<size_t[]>(buf);
+		}
 		pt_benchmark(pop2_empty_t8, __bvn, 16'192, 8)
 		{
 			mpmc_lifo2<size_t> queue(16'192 * 128);
@@ -113,4 +503,245 @@ namespace pul
 				return queue.try_dequeue(); });
 		}
 	}
+
+	// SPMC Deque
+	pt_pack(spmc_deque_pack)
+	{
+		pt_unit(push_pop_steal_unit)
+		{
+			spmc_deque<size_t> deque(1'024);
+			size_t buf[1'024] = { 0 };
+			for(size_t i = 0; i < 1'024; ++i)
+			{
+				buf[i] = i;
+				pt_check(deque.try_push(&buf[i]));
+			}
+			pt_check(!deque.try_push(&buf[0]));
+			pt_check(deque.try_pop() == &buf[1'023]);	 // Owner => LIFO
+			pt_check(deque.try_steal() == &buf[0]);		 // Thieves => FIFO
+			pt_check(deque.size() == 1'022);
+			while(deque.try_pop())
+				;
+			pt_check(deque.empty());
+			pt_check(deque.try_steal() == nullptr);
+		}
+		pt_benchmark(steal_t8, __bvn, 16'192, 8)
+		{
+			spmc_deque<size_t> deque(16'384 * 8);
+			size_t *buf = new_construct<size_t[]>(__bvn.num_iterations());
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i)
+			{
+				buf[i] = i;
+				deque.try_push(&buf[i]);
+			}
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				return deque.try_steal(); });
+			destroy_delete<size_t[]>(buf);
+		}
+	}
+
+	// Concurrent Hash Map
+	pt_pack(concurrent_hash_map_pack)
+	{
+		pt_unit(insert_find_erase_unit)
+		{
+			concurrent_hash_map<uint64_t, uint64_t> map(8);
+			for(uint64_t i = 0; i != 4'096; ++i) pt_check(map.insert(i, i * 2));	// Resizes on the way
+			pt_check(!map.insert(42, 0));
+			pt_check(map.size() == 4'096);
+			pt_check(map.capacity() >= 4'096);
+			uint64_t v = 0;
+			pt_check(map.find(42, v) && v == 84);
+			pt_check(!map.insert_or_assign(42, 7));
+			pt_check(map.find(42, v) && v == 7);
+			for(uint64_t i = 0; i != 4'096; i += 2) pt_check(map.erase(i));
+			pt_check(!map.erase(0));
+			pt_check(!map.contains(0));
+			pt_check(map.contains(1));
+			pt_check(map.size() == 2'048);
+			pt_check(map.insert(0, 1));
+			pt_check(map.visit(0, [&v](uint64_t const &__v)
+												 { v = __v; }));
+			pt_check(v == 1);
+		}
+		pt_unit(concurrent_insert_unit)
+		{
+			const uint64_t n = 65'536;
+			concurrent_hash_map<uint64_t, uint64_t> map(64);
+			std::thread w[4];
+			for(uint64_t t = 0; t != 4; ++t)
+			{
+				w[t] = std::thread(
+				 [&, t]()
+				 {
+					 for(uint64_t i = t; i < n; i += 4) ignore = map.insert(i, i);
+				 });
+			}
+			uint64_t v = 0;
+			bool same	 = true;
+			for(uint64_t i = 0; i != n; ++i)	// NOTE: Reads race with the resizes, a key may not be there yet
+			{
+				if(map.find(i, v)) same &= v == i;
+			}
+			for(auto &x: w) x.join();
+			pt_check(same);
+			uint64_t f = 0;
+			for(uint64_t i = 0; i != n; ++i) f += map.find(i, v) && v == i;
+			pt_check(f == n);
+			pt_check(map.size() == n);
+		}
+		pt_benchmark(map_read_t1, __bvn, 16'192, 1)
+		{
+			concurrent_hash_map<size_t, size_t> map(16'192);
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i) ignore = map.insert(i, i);
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				size_t v = 0;
+				ignore = map.find(__index, v);
+				return v; });
+		}
+		pt_benchmark(map_write_t1, __bvn, 16'192, 1)
+		{
+			concurrent_hash_map<size_t, size_t> map;
+			__bvn.measure(
+			 [&](size_t __index)
+			 { return map.insert_or_assign(__index, __index); });
+		}
+		pt_benchmark(map_read_t8, __bvn, 16'192, 8)
+		{
+			concurrent_hash_map<size_t, size_t> map(16'192);
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i) ignore = map.insert(i, i);
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				size_t v = 0;
+				ignore = map.find(__index, v);
+				return v; });
+		}
+		pt_benchmark(map_write_t8, __bvn, 16'192, 8)
+		{
+			concurrent_hash_map<size_t, size_t> map;
+			__bvn.measure(
+			 [&](size_t __index)
+			 { return map.insert_or_assign(__index, __index); });
+		}
+		pt_benchmark(map_read_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			concurrent_hash_map<size_t, size_t> map(16'192);
+			for(size_t i = 0; i < __bvn.num_iterations(); ++i) ignore = map.insert(i, i);
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				size_t v = 0;
+				ignore = map.find(__index, v);
+				return v; });
+		}
+		pt_benchmark(map_write_tn, __bvn, 16'192, CCY_NUM_THREADS)
+		{
+			concurrent_hash_map<size_t, size_t> map;
+			__bvn.measure(
+			 [&](size_t __index)
+			 { return map.insert_or_assign(__index, __index); });
+		}
+	}
+
+	// Reclamation
+	pf_decl_static atomic<size_t> __reclaim_num_deleted = 0;
+	struct __reclaim_deleter_t
+	{
+		void
+		operator()(
+		 size_t *__p) const pf_attr_noexcept
+		{
+			destroy_delete(__p);
+			__reclaim_num_deleted.fetch_add(1, atomic_order::relaxed);
+		}
+	};
+	struct __reclaim_chain_deleter_t
+	{
+		void
+		operator()(
+		 size_t *__p) const
+		{
+			if(*__p != 0) hazard_retire<size_t, __reclaim_chain_deleter_t>(new_construct<size_t>(*__p - 1));	// NOTE: Retires while being reclaimed
+			destroy_delete(__p);
+			__reclaim_num_deleted.fetch_add(1, atomic_order::relaxed);
+		}
+	};
+	pt_pack(reclamation_pack)
+	{
+		pt_unit(hazard_unit)
+		{
+			const size_t n = __reclaim_num_deleted.load(atomic_order::relaxed);
+			atomic<size_t *> src(new_construct<size_t>(42));
+			hazard_pointer hp;
+			pt_check(hp.is_valid());
+			size_t *p = hp.protect(src);
+			pt_check(*p == 42);
+			src.store(nullptr, atomic_order::release);
+			hazard_retire<size_t, __reclaim_deleter_t>(p);
+			hazard_reclaim();
+			pt_check(__reclaim_num_deleted.load(atomic_order::relaxed) == n);	// Still protected
+			hp.reset();
+			hazard_reclaim();
+			pt_check(__reclaim_num_deleted.load(atomic_order::relaxed) == n + 1);
+			pt_check(hazard_num_retired() == 0);
+
+			hazard_pointer more[CCY_HAZARD_NUM_SLOTS - 1];	// NOTE: With hp, every slot of this thread is taken
+			bool thrown = false;
+			try
+			{
+				hazard_pointer extra;
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+		}
+		pt_unit(hazard_retire_from_deleter)
+		{
+			const size_t n = __reclaim_num_deleted.load(atomic_order::relaxed);
+			hazard_retire<size_t, __reclaim_chain_deleter_t>(new_construct<size_t>(3));
+			for(size_t i = 0; i != 4; ++i) hazard_reclaim();
+			pt_check(__reclaim_num_deleted.load(atomic_order::relaxed) == n + 4);
+			pt_check(hazard_num_retired() == 0);
+		}
+		pt_unit(epoch_unit)
+		{
+			const size_t n = __reclaim_num_deleted.load(atomic_order::relaxed);
+			{
+				epoch_guard g;
+				epoch_retire<size_t, __reclaim_deleter_t>(new_construct<size_t>(42));
+				epoch_reclaim();
+				epoch_reclaim();
+				pt_check(__reclaim_num_deleted.load(atomic_order::relaxed) == n);	 // Pinned, the epoch advances once at most
+			}
+			for(size_t i = 0; i != 3; ++i) epoch_reclaim();
+			pt_check(__reclaim_num_deleted.load(atomic_order::relaxed) == n + 1);
+			pt_check(epoch_num_retired() == 0);
+		}
+		pt_benchmark(hazard_protect_t8, __bvn, 16'192, 8)
+		{
+			size_t v = 0;
+			atomic<size_t *> src(&v);
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				ignore = __index;
+				hazard_pointer hp;	// NOTE: Slots belong to the measuring thread
+				return hp.protect(src); });
+		}
+		pt_benchmark(epoch_guard_t8, __bvn, 16'192, 8)
+		{
+			__bvn.measure(
+			 [&](size_t __index)
+			 {
+				epoch_guard g;
+				return __index; });
+		}
+	}
 }	 // namespace pul
@@ -11,6 +11,17 @@
 // Include: Pulsar
 #include "pulsar/thread_pool.hpp"
 
+// Include: OS
+#ifdef PF_OS_WINDOWS
+ #include <windows.h>
+#else	 // ^^^ PF_OS_WINDOWS ^^^ / vvv PF_OS_LINUX vvv
+ #include <sys/resource.h>
+#endif	// PF_OS_WINDOWS
+
+// Include: C++
+#include <algorithm>
+#include <thread>
+
 // Include: Pulsar -> Tester
 #include "pulsar_tester/pulsar_tester.hpp"
 
@@ -37,6 +48,165 @@ namespace pul
 	// Thread Pool
 	pt_pack(thread_pool)
 	{
+		// Work-Stealing
+		pf_decl_static void
+		__task_fork(
+		 atomic<uint32_t> *__count,
+		 uint32_t __depth)
+		{
+			__count->fetch_add(1, atomic_order::relaxed);
+			if(__depth == 0) return;
+			submit_task(
+			 [__count, __depth]()
+			 { __task_fork(__count, __depth - 1); });
+			submit_task(
+			 [__count, __depth]()
+			 { __task_fork(__count, __depth - 1); });
+		}
+		template<size_t _Size>
+		pf_decl_static float64_t
+		__task_allocations_per_submit(
+		 size_t __num)
+		{
+			atomic<size_t> count = 0;
+			byte_t payload[_Size] = { 0 };
+			const size_t a				= thread_pool_num_allocations();
+			for(size_t i = 0; i != __num; i += 1'024)
+			{
+				const size_t n = i + 1'024 < __num ? 1'024 : __num - i;
+				for(size_t j = 0; j != n; ++j)
+				{
+					submit_task(
+					 [&count, payload]()
+					 { count.fetch_add(payload[0] + 1, atomic_order::relaxed); });
+				}
+				while(count.load(atomic_order::relaxed) != i + n) process_tasks();
+			}
+			return static_cast<float64_t>(thread_pool_num_allocations() - a) / static_cast<float64_t>(__num);
+		}
+		pf_decl_static float64_t
+		__process_cpu_seconds() pf_attr_noexcept
+		{
+#ifdef PF_OS_WINDOWS
+			FILETIME c, e, k, u;
+			if(!GetProcessTimes(GetCurrentProcess(), &c, &e, &k, &u)) return 0.0;
+			const uint64_t kt = (union_cast<uint64_t>(k.dwHighDateTime) << 32) | k.dwLowDateTime;
+			const uint64_t ut = (union_cast<uint64_t>(u.dwHighDateTime) << 32) | u.dwLowDateTime;
+			return static_cast<float64_t>(kt + ut) / 10'000'000.0;	// NOTE: 100ns units
+#else		// ^^^ PF_OS_WINDOWS ^^^ / vvv PF_OS_LINUX vvv
+			rusage r;
+			if(getrusage(RUSAGE_SELF, &r) != 0) return 0.0;
+			return static_cast<float64_t>(r.ru_utime.tv_sec + r.ru_stime.tv_sec)
+					 + static_cast<float64_t>(r.ru_utime.tv_usec + r.ru_stime.tv_usec) / 1'000'000.0;
+#endif	// PF_OS_WINDOWS
+		}
+		struct __bulk_fun_t
+		{
+			void
+			operator()() const
+			{
+				this->count->fetch_add(1, atomic_order::relaxed);
+			}
+
+			atomic<uint32_t> *count;
+		};
+		pf_decl_static uint32_t
+		__task_nested_join(
+		 uint32_t __depth)
+		{
+			if(__depth == 0) return 1;
+			auto f = submit_future_task(
+			 [__depth]()
+			 { return __task_nested_join(__depth - 1); });
+			return f.value() + 1;	 // NOTE: Waits from a worker, it must help instead of spinning
+		}
+		pf_decl_static uint64_t
+		__task_group_fib(
+		 uint32_t __n)
+		{
+			if(__n < 2) return __n;
+			uint64_t a = 0, b = 0;
+			task_group_t g;
+			g.run([&a, __n]()
+						{ a = __task_group_fib(__n - 1); });
+			b = __task_group_fib(__n - 2);
+			g.wait();	 // NOTE: Nested, helps the pool instead of blocking a worker
+			return a + b;
+		}
+		pf_decl_static void
+		__task_priority_latency(
+		 task_priority __bulk,
+		 task_priority __probe)
+		{
+			// Saturate
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> left = 0;
+			const uint32_t n														 = CCY_NUM_WORKERS * 256;
+			left.store(n, atomic_order::relaxed);
+			for(uint32_t i = 0; i != n; ++i)
+			{
+				submit_task(
+				 __bulk,
+				 [l = &left]()
+				 {
+					const high_resolution_point_t s = high_resolution_clock_t::now();
+					while(high_resolution_clock_t::now() - s < nanoseconds_t(50'000))
+						;
+					l->fetch_sub(1, atomic_order::relaxed);
+				});
+			}
+
+			// Probe
+			nanoseconds_t l[128];
+			for(size_t i = 0; i != 128; ++i)
+			{
+				const high_resolution_point_t s = high_resolution_clock_t::now();
+				auto f													= submit_future_task(__probe, []()
+																						 { return high_resolution_clock_t::now(); });
+				l[i]														= f.value() - s;
+			}
+			std::sort(begin(l), end(l));
+			pf_print("Priority latency: bulk={}, probe={}, p50={}ns, p99={}ns, max={}ns\n",
+							 union_cast<uint32_t>(__bulk),
+							 union_cast<uint32_t>(__probe),
+							 l[64].count(),
+							 l[126].count(),
+							 l[127].count());
+
+			// Drain
+			while(left.load(atomic_order::relaxed) != 0) process_tasks();
+		}
+
+		pf_decl_static future<int32_t>
+		__co_add(
+		 int32_t __a,
+		 int32_t __b)
+		{
+			const int32_t a = co_await submit_future_task([__a]()
+																										{ return __a; });
+			const int32_t b = co_await submit_future_task([__b]()
+																										{ return __b; });
+			co_return a + b;
+		}
+		pf_decl_static future<void>
+		__co_count(
+		 atomic<uint32_t> *__count)
+		{
+			for(uint32_t i = 0; i != 16; ++i)
+			{
+				co_await __co_add(union_cast<int32_t>(i), 1);
+				__count->fetch_add(1, atomic_order::relaxed);
+			}
+		}
+		pf_decl_static future<thread_id_t>
+		__co_main()
+		{
+			co_await co_schedule();
+			auto v = submit_future_task([]()
+																	{ return this_thread::get_idx(); });
+			co_await v.await_0();
+			co_return this_thread::get_idx();
+		}
+
 		// Task
 		pt_unit(task_submit)
 		{
@@ -53,6 +223,33 @@ namespace pul
 			 10);
 		}
 
+		pt_unit(task_submit_priority)
+		{
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> count = 0;
+			submit_task(
+			 task_priority::critical,
+			 [c = &count]()
+			 { c->fetch_add(1, atomic_order::relaxed); });
+			submit_task(
+			 task_priority::normal,
+			 [c = &count]()
+			 { c->fetch_add(1, atomic_order::relaxed); });
+			submit_task(
+			 task_priority::background,
+			 [c = &count]()
+			 { c->fetch_add(1, atomic_order::relaxed); });
+			auto f = submit_future_task(task_priority::critical, [](size_t __i)
+																	{ return __i; },
+																	10);
+			pt_check(f.value() == 10);
+			while(count.load(atomic_order::relaxed) != 3) process_tasks();
+		}
+		pt_unit(task_priority_tail_latency)
+		{
+			__task_priority_latency(task_priority::normal, task_priority::normal);
+			__task_priority_latency(task_priority::background, task_priority::critical);
+		}
+
 		pt_benchmark(task_submit_benchmark_t1, __bvn, 2'048, 1)
 		{
 			__bvn.measure(
@@ -75,6 +272,576 @@ namespace pul
 				return __i;
 			});
 		}
+		pt_benchmark(task_shared_throughput_benchmark_t1, __bvn, 64, 1)
+		{
+			// NOTE: Submitted from outside the pool, every task goes through the single shared queue
+			__bvn.measure(
+			 [&](size_t)
+			 {
+				pf_alignas(CCY_ALIGN) atomic<uint32_t> count = 0;
+				for(uint32_t i = 0; i != 1'023; ++i)
+				{
+					submit_task(
+					 [c = &count]()
+					 { c->fetch_add(1, atomic_order::relaxed); });
+				}
+				while(count.load(atomic_order::relaxed) != 1'023) process_tasks();
+				return count.load(atomic_order::relaxed);
+			});
+		}
+		pt_benchmark(task_stealing_throughput_benchmark_t1, __bvn, 64, 1)
+		{
+			// NOTE: Same number of tasks, forked by the workers on their deques and stolen by the idle ones
+			__bvn.measure(
+			 [&](size_t)
+			 {
+				pf_alignas(CCY_ALIGN) atomic<uint32_t> count = 0;
+				submit_task(
+				 [c = &count]()
+				 { __task_fork(c, 9); });
+				while(count.load(atomic_order::relaxed) != 1'023) process_tasks();
+				return count.load(atomic_order::relaxed);
+			});
+		}
+		pt_unit(task_submit_bulk)
+		{
+			atomic<uint32_t> count = 0;
+			sequence<__bulk_fun_t> funs(__bulk_fun_t { &count }, 4'096);
+			submit_tasks_bulk(funs.begin(), funs.end());
+			while(count.load(atomic_order::relaxed) != 4'096) process_tasks();
+
+			atomic<uint32_t> sum = 0;
+			submit_task_n(
+			 4'096,
+			 [&sum](size_t __i)
+			 { sum.fetch_add(static_cast<uint32_t>(__i), atomic_order::relaxed); });
+			while(sum.load(atomic_order::relaxed) != 4'095 * 4'096 / 2) process_tasks();
+		}
+		pt_unit(task_submit_bulk_vs_single)
+		{
+			atomic<uint32_t> count = 0;
+			const high_resolution_point_t s = high_resolution_clock_t::now();
+			for(uint32_t f = 0; f != 16; ++f)
+			{
+				for(uint32_t i = 0; i != 4'096; ++i) submit_task(__bulk_fun_t { &count });
+				while(count.load(atomic_order::relaxed) != (f + 1) * 4'096) process_tasks();
+			}
+			const high_resolution_point_t m = high_resolution_clock_t::now();
+			for(uint32_t f = 16; f != 32; ++f)
+			{
+				submit_task_n(
+				 4'096,
+				 [&count](size_t)
+				 { count.fetch_add(1, atomic_order::relaxed); });
+				while(count.load(atomic_order::relaxed) != (f + 1) * 4'096) process_tasks();
+			}
+			const high_resolution_point_t e = high_resolution_clock_t::now();
+			pf_print("Submit 16x4096 tasks: single={}ns, bulk={}ns\n", (m - s).count(), (e - m).count());
+		}
+		pt_unit(task_topology_affinity)
+		{
+			const uint32_t n = cpu_topology_num_cpus();
+			pf_print("Topology: cpus={}, cores={}, caches={}, quota={}, threads={}\n", n, cpu_topology_num_cores(), cpu_topology_num_caches(), cpu_topology_quota(), CCY_NUM_THREADS);
+			pt_check(n > 0);
+			pt_check(cpu_topology_num_cores() <= n);
+			pt_check(cpu_topology_num_caches() <= cpu_topology_num_cores());
+			pt_check(cpu_topology_quota() == 0 || CCY_NUM_THREADS <= (cpu_topology_quota() < 2 ? 2 : cpu_topology_quota()));
+			for(uint32_t i = 0; i != n; ++i) pt_check(cpu_topology_get(i).core < cpu_topology_num_cores());
+
+			if(thread_pool_set_affinity(thread_affinity::physical_core))
+			{
+				pt_check(thread_pool_affinity() == thread_affinity::physical_core);
+				auto f = submit_future_task([]()
+																		{ return 1; });
+				pt_check(f.value() == 1);
+			}
+			pt_check(thread_pool_set_affinity(thread_affinity::none));
+			pt_check(thread_pool_affinity() == thread_affinity::none);
+		}
+		pt_unit(thread_pool_instances)
+		{
+			thread_pool_t io(2);
+			pt_check(io.num_workers() == 2);
+
+			// Blocking work on the io pool doesn't stall the global one
+			atomic<uint32_t> blocked = 0;
+			for(uint32_t i = 0; i != 2; ++i)
+			{
+				io.submit_task(
+				 [&blocked]()
+				 {
+					 blocked.fetch_add(1, atomic_order::relaxed);
+					 this_thread::sleep_for(nanoseconds_t(100'000'000));
+				 });
+			}
+			auto f = submit_future_task([]()
+																	{ return 7; });
+			pt_check(f.value() == 7);
+			auto g = io.submit_future_task([]()
+																		 { return 3; });
+			pt_check(g.value() == 3);
+			while(blocked.load(atomic_order::relaxed) != 2) this_thread::yield();
+
+			io.resize(4);
+			pt_check(io.num_workers() == 4);
+		}
+		pt_unit(thread_pool_resize)
+		{
+			const uint32_t n = thread_pool_num_workers();
+			thread_pool_resize(1);
+			pt_check(thread_pool_num_workers() == 1);
+			atomic<size_t> sum = 0;
+			parallel_for(
+			 size_t(0),
+			 size_t(1'024),
+			 [&sum](size_t __i)
+			 { sum.fetch_add(__i, atomic_order::relaxed); });
+			pt_check(sum.load(atomic_order::relaxed) == 1'023 * 1'024 / 2);
+			thread_pool_resize(n);
+			pt_check(thread_pool_num_workers() == n);
+		}
+		pt_unit(thread_pool_resize_from_task)
+		{
+			thread_pool_t io(2);
+			auto f = io.submit_future_task(
+			 [&io]()
+			 {
+				 bool thrown = false;
+				 try
+				 {
+					 io.resize(3);
+				 } catch(const dbg_exception &__e)
+				 {
+					 thrown = __e.category() == dbg_category_generic();
+				 }
+				 return thrown;
+			 });
+			pt_check(f.value());
+			pt_check(io.num_workers() == 2);
+		}
+		pt_unit(thread_pool_capacity)
+		{
+			const size_t c = thread_pool_capacity();
+			thread_pool_set_capacity(c * 2);
+			pt_check(thread_pool_capacity() >= c * 2);
+			atomic<size_t> count = 0;
+			for(size_t i = 0; i != 1'024; ++i)
+			{
+				pt_check(try_submit_task(
+				 [&count]()
+				 { count.fetch_add(1, atomic_order::relaxed); }));
+			}
+			while(count.load(atomic_order::relaxed) != 1'024) this_thread::yield();
+			thread_pool_set_capacity(0);
+			pt_check(thread_pool_capacity() == c);
+		}
+		pt_unit(thread_pool_stats)
+		{
+			const thread_pool_stats_t b = thread_pool_stats();
+			atomic<size_t> count				= 0;
+			for(size_t i = 0; i != 4'096; ++i)
+			{
+				submit_task([&count]()
+										{ count.fetch_add(1, atomic_order::relaxed); });
+			}
+			while(count.load(atomic_order::relaxed) != 4'096) this_thread::yield();
+			while(thread_pool_stats().numExecuted - b.numExecuted < 4'096) this_thread::yield();	// NOTE: Counted once a batch ends
+			const thread_pool_stats_t a = thread_pool_stats();
+			pt_check(a.numLocal + a.numShared + a.numStolen >= a.numExecuted);
+			pt_check(a.numDepthSamples > b.numDepthSamples);
+			pt_check(a.busyTime + a.idleTime > 0);
+			pt_check(thread_pool_worker_stats(0).numExecuted <= a.numExecuted);
+
+			bool thrown = false;
+			try
+			{
+				ignore = thread_pool_worker_stats(thread_pool_num_workers());
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+		}
+		pt_unit(task_overflow_policies)
+		{
+			thread_pool_t p(1, 1);	// NOTE: Smallest lanes, the single worker is held by the gate
+			atomic<bool> started = false;
+			atomic<bool> gate		 = false;
+			atomic<size_t> count = 0;
+			p.submit_task(
+			 [&started, &gate]()
+			 {
+				 started.store(true, atomic_order::release);
+				 while(!gate.load(atomic_order::acquire)) this_thread::yield();
+			 });
+			while(!started.load(atomic_order::acquire)) this_thread::yield();
+
+			// Fail -> Refused once full
+			p.set_overflow(task_overflow::fail);
+			size_t n = 0;
+			while(p.submit_task(
+			 [&count]()
+			 { count.fetch_add(1, atomic_order::relaxed); }))
+			{
+				++n;
+			}
+			pt_check(n > 0);
+			pt_check(p.num_pending() == n + 1);
+
+			// Run Inline -> Done before returning
+			p.set_overflow(task_overflow::run_inline);
+			pt_check(p.submit_task(
+			 [&count]()
+			 { count.fetch_add(1, atomic_order::relaxed); }));
+			pt_check(count.load(atomic_order::relaxed) == 1);
+
+			// Block -> Waits for the worker
+			gate.store(true, atomic_order::release);
+			p.set_overflow(task_overflow::block);
+			pt_check(p.submit_task(
+			 [&count]()
+			 { count.fetch_add(1, atomic_order::relaxed); }));
+			while(count.load(atomic_order::relaxed) != n + 2) this_thread::yield();
+		}
+		pt_unit(task_nested_fork_join)
+		{
+			const uint32_t d = CCY_NUM_WORKERS + 4;
+			auto f					 = submit_future_task(
+				[d]()
+				{ return __task_nested_join(d); });
+			pt_check(f.value() == d + 1);
+		}
+		pt_unit(task_group_fork_join)
+		{
+			pt_check(__task_group_fib(20) == 6'765);
+		}
+		pt_unit(task_group_exception)
+		{
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> count = 0;
+			task_group_t g;
+			for(uint32_t i = 0; i != 16; ++i)
+			{
+				g.run([&count](uint32_t __i)
+							{
+								count.fetch_add(1, atomic_order::relaxed);
+								if(__i % 4 == 0) pf_throw(dbg_category_generic(), dbg_code::invalid_argument, dbg_flags::none, "Task {} failed!", __i); },
+							i);
+			}
+			bool thrown = false;
+			try
+			{
+				g.wait();
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+			pt_check(count.load(atomic_order::relaxed) == 16);	// NOTE: A throw doesn't cancel its siblings
+			pt_check(g.num_exceptions() == 4);
+			pt_check(!g.wait());
+			pt_check(g.num_exceptions() == 0);
+		}
+		pt_unit(task_timer_after)
+		{
+			atomic<bool> done							= false;
+			const high_resolution_point_t s = high_resolution_clock_t::now();
+			high_resolution_point_t e;
+			submit_task_after(
+			 milliseconds_t(20),
+			 [&]()
+			 {
+				 e = high_resolution_clock_t::now();
+				 done.store(true, atomic_order::release);
+			 });
+			while(!done.load(atomic_order::acquire)) this_thread::yield();
+			pf_print("Timer after 20ms fired after {}ns\n", (e - s).count());
+			pt_check(e - s >= milliseconds_t(20));
+		}
+		pt_unit(task_timer_order)
+		{
+			atomic<uint32_t> order				= 0;
+			atomic<uint32_t> fired[3]			= { 0, 0, 0 };	// NOTE: Written by the workers running the tasks
+			const high_resolution_point_t s = high_resolution_clock_t::now();
+			submit_task_at(s + milliseconds_t(30), [&]()
+										 { fired[2].store(order.fetch_add(1, atomic_order::relaxed) + 1, atomic_order::relaxed); });
+			submit_task_at(s + milliseconds_t(10), [&]()
+										 { fired[0].store(order.fetch_add(1, atomic_order::relaxed) + 1, atomic_order::relaxed); });
+			submit_task_at(s + milliseconds_t(20), [&]()
+										 { fired[1].store(order.fetch_add(1, atomic_order::relaxed) + 1, atomic_order::relaxed); });
+			while(fired[0].load(atomic_order::relaxed) == 0 || fired[1].load(atomic_order::relaxed) == 0 || fired[2].load(atomic_order::relaxed) == 0) this_thread::yield();
+			pt_check(fired[0].load(atomic_order::relaxed) == 1 && fired[1].load(atomic_order::relaxed) == 2 && fired[2].load(atomic_order::relaxed) == 3);
+		}
+		pt_unit(task_timer_every)
+		{
+			atomic<uint32_t> n = 0;
+			submit_task_every(
+			 milliseconds_t(5),
+			 [&n]()
+			 { return n.fetch_add(1, atomic_order::relaxed) + 1 != 4; });
+			while(n.load(atomic_order::relaxed) != 4) this_thread::yield();
+			this_thread::sleep_for(nanoseconds_t(20'000'000));
+			pt_check(n.load(atomic_order::relaxed) == 4);
+
+			bool thrown = false;
+			try
+			{
+				submit_task_every(
+				 milliseconds_t(0),
+				 []() {});
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+		}
+		pt_benchmark(task_timer_schedule_benchmark_t1, __bvn, 65'536, 1)
+		{
+			const high_resolution_point_t s = high_resolution_clock_t::now() + hours_t(1);
+			__bvn.measure(
+			 [&](size_t __i)
+			 {
+				submit_task_at(s + milliseconds_t(__i), [](){});
+				return __i;
+			});
+		}
+		pt_unit(task_fork_join)
+		{
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> count = 0;
+			submit_task(
+			 [c = &count]()
+			 { __task_fork(c, 12); });
+			while(count.load(atomic_order::relaxed) != 8'191) process_tasks();
+			pt_check(count.load(atomic_order::relaxed) == 8'191);
+		}
+		pt_unit(task_wake_up_latency)
+		{
+			nanoseconds_t sum(0);
+			nanoseconds_t max(0);
+			for(size_t i = 0; i < 64; ++i)
+			{
+				this_thread::sleep_for(nanoseconds_t(5'000'000));	 // NOTE: Workers are parked
+				const high_resolution_point_t s = high_resolution_clock_t::now();
+				auto f													= submit_future_task([]()
+																						 { return high_resolution_clock_t::now(); });
+				const nanoseconds_t l						= f.value() - s;
+				sum														 += l;
+				if(l > max) max = l;
+			}
+			pf_print("Wake-up latency: avg={}ns, max={}ns, spin budget={}\n", sum.count() / 64, max.count(), thread_pool_spin_budget());
+		}
+		pt_unit(task_spin_budget)
+		{
+			const uint32_t b = thread_pool_spin_budget();
+			thread_pool_set_spin_budget(0);
+			pt_check(thread_pool_spin_budget() == 0);
+			auto f = submit_future_task([]()
+																	{ return 42; });
+			pt_check(f.value() == 42);
+			thread_pool_set_spin_budget(b);
+			pt_check(thread_pool_spin_budget() == b);
+		}
+		pt_unit(task_idle_cpu)
+		{
+			this_thread::sleep_for(nanoseconds_t(50'000'000));	// NOTE: Lets the workers spend their spin budget and park
+			const float64_t c								= __process_cpu_seconds();
+			const high_resolution_point_t s = high_resolution_clock_t::now();
+			this_thread::sleep_for(nanoseconds_t(250'000'000));
+			const float64_t cpu	 = __process_cpu_seconds() - c;
+			const float64_t wall = static_cast<float64_t>((high_resolution_clock_t::now() - s).count()) / 1'000'000'000.0;
+			pf_print("Idle CPU: {:.2f}% of one core over {:.3f}s\n", 100.0 * cpu / wall, wall);
+			pt_check(cpu < wall * 0.05);	// NOTE: Parked workers, under 5% of one core
+		}
+		pt_unit(task_allocations_per_submit)
+		{
+			const float64_t small = __task_allocations_per_submit<8>(10'000);
+			const float64_t large = __task_allocations_per_submit<1'024>(10'000);	// NOTE: Too large for a bin, falls back to the cache allocator
+			pf_print("Allocations per submit: slab={:.4f}, fallback={:.4f}\n", small, large);
+			pt_check(small < 0.01);
+			pt_check(large >= 1.0);
+
+			atomic<size_t> n = 0;
+			const size_t a	 = thread_pool_num_allocations();
+			for(size_t i = 0; i != 1'024; ++i)
+			{
+				auto f = submit_future_task(
+				 [&n]()
+				 { return n.fetch_add(1, atomic_order::relaxed); });
+				f.wait();
+			}
+			pf_print("Allocations per future submit: {:.4f}\n", static_cast<float64_t>(thread_pool_num_allocations() - a) / 1'024.0);
+			pt_check(thread_pool_num_allocations() - a < 16);
+		}
+		pt_unit(task_slab_thread_exit)
+		{
+			// NOTE: Each thread adopts the cache of the previous one instead of carving new chunks
+			const size_t a = thread_pool_num_allocations();
+			for(size_t i = 0; i != 64; ++i)
+			{
+				std::thread t(
+				 []()
+				 {
+					 atomic<bool> done = false;
+					 submit_task(
+						[&done]()
+						{ done.store(true, atomic_order::release); });
+					 while(!done.load(atomic_order::acquire)) this_thread::yield();
+				 });
+				t.join();
+			}
+			pt_check(thread_pool_num_allocations() - a < 8);
+		}
+
+		pt_unit(parallel_for_index)
+		{
+			sequence<uint32_t> s(0, 100'000);
+			parallel_for(
+			 0,
+			 s.count(),
+			 [&](size_t __i)
+			 { s[__i] = union_cast<uint32_t>(__i); });
+			for(size_t i = 0; i != s.count(); ++i) pt_check(s[i] == i);
+
+			size_t n = 0;
+			parallel_for(
+			 size_t(10),
+			 size_t(5),
+			 [&n](size_t)
+			 { ++n; });	// NOTE: Reversed bounds are an empty range
+			pt_check(n == 0);
+		}
+		pt_unit(parallel_for_sequence)
+		{
+			sequence<uint32_t> s(1, 100'000);
+			parallel_for(
+			 s,
+			 [](uint32_t &__v)
+			 { __v *= 2; },
+			 64);
+			pt_check(equal(s.begin(), s.end(), 2u));
+		}
+		pt_unit(parallel_reduce_sum)
+		{
+			sequence<uint64_t> s(1, 1'000'000);
+			pt_check(parallel_reduce(s.begin(), s.end(), uint64_t(0)) == 1'000'000);
+			pt_check(parallel_reduce(
+								s,
+								uint64_t(5),
+								[](uint64_t __l, uint64_t __r)
+								{ return __l + __r; })
+							 == 1'000'005);
+		}
+		pt_unit(parallel_transform_square)
+		{
+			sequence<uint64_t> i(3, 100'000);
+			sequence<uint64_t> o(0, 100'000);
+			auto e = parallel_transform(
+			 i.begin(),
+			 i.end(),
+			 o.begin(),
+			 [](uint64_t __v)
+			 { return __v * __v; });
+			pt_check(e == o.end());
+			pt_check(equal(o.begin(), o.end(), uint64_t(9)));
+		}
+		pt_unit(parallel_pipeline_in_order)
+		{
+			const uint64_t n = 10'000;
+			uint64_t next = 0, sum = 0;
+			bool ordered = true;
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> inFlight = 0;
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> maxInFlight = 0;
+			parallel_pipeline(
+			 8,
+			 make_pipeline_stage<void, uint64_t>(
+				pipeline_mode::serial_in_order,
+				[&next, n, &inFlight](pipeline_control &__c)
+				{
+					if(next == n) __c.stop();
+					else inFlight.fetch_add(1, atomic_order::relaxed);
+					return next++;
+				}),
+			 make_pipeline_stage<uint64_t, uint64_t>(
+				pipeline_mode::parallel,
+				[&inFlight, &maxInFlight](uint64_t __v)
+				{
+					uint32_t c = inFlight.load(atomic_order::relaxed);
+					uint32_t m = maxInFlight.load(atomic_order::relaxed);
+					while(c > m && !maxInFlight.compare_exchange_weak(m, c, atomic_order::relaxed, atomic_order::relaxed));
+					return __v * 2;
+				}),
+			 make_pipeline_stage<uint64_t, void>(
+				pipeline_mode::serial_in_order,
+				[&sum, &ordered, &inFlight](uint64_t __v)
+				{
+					ordered &= __v == sum;	// NOTE: 2 * i arrives once 0 .. i - 1 did
+					sum			+= 2;
+					inFlight.fetch_sub(1, atomic_order::relaxed);
+				}));
+			pt_check(ordered);
+			pt_check(sum == 2 * n);
+			pt_check(maxInFlight.load(atomic_order::relaxed) <= 8);
+		}
+		pt_unit(parallel_pipeline_exception)
+		{
+			uint64_t next = 0;
+			pf_alignas(CCY_ALIGN) atomic<uint64_t> count = 0;
+			bool thrown = false;
+			try
+			{
+				parallel_pipeline(
+				 4,
+				 make_pipeline_stage<void, uint64_t>(
+					pipeline_mode::serial_in_order,
+					[&next](pipeline_control &__c)
+					{
+						if(next == 1'000) __c.stop();
+						return next++;
+					}),
+				 make_pipeline_stage<uint64_t, void>(
+					pipeline_mode::serial_out_of_order,
+					[&count](uint64_t __v)
+					{
+						count.fetch_add(1, atomic_order::relaxed);
+						if(__v == 100) pf_throw(dbg_category_generic(), dbg_code::invalid_argument, dbg_flags::none, "Item {} failed!", __v);
+					}));
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+			pt_check(count.load(atomic_order::relaxed) < 1'000);	// NOTE: The source stops after a throw
+		}
+		pt_unit(parallel_for_vs_futures)
+		{
+			sequence<float64_t> s(1.0, 4'000'000);
+			const size_t c = s.count();
+			const size_t g = c / (CCY_NUM_THREADS * 16);
+
+			// Futures
+			high_resolution_point_t t = high_resolution_clock_t::now();
+			{
+				sequence<future<void>> f;
+				f.reserve(c / g + 1);	 // NOTE: future is not relocatable
+				for(size_t b = 0; b < c; b += g)
+				{
+					f.push_back(submit_future_task(
+					 [p = s.data(), b, e = std::min(c, b + g)]()
+					 {
+						for(size_t i = b; i != e; ++i) p[i] = p[i] * 0.5 + 1.0;
+					}));
+				}
+			}
+			const nanoseconds_t lf = high_resolution_clock_t::now() - t;
+
+			// Parallel
+			t = high_resolution_clock_t::now();
+			parallel_for(
+			 s,
+			 [](float64_t &__v)
+			 { __v = __v * 0.5 + 1.0; });
+			const nanoseconds_t lp = high_resolution_clock_t::now() - t;
+			pf_print("Parallel for: futures={}ns, parallel_for={}ns\n", lf.count(), lp.count());
+		}
 		pt_unit(future_task_submit)
 		{
 			auto f = submit_future_task([](size_t __i)
@@ -90,6 +857,230 @@ namespace pul
 			process_tasks_0();
 			f.wait();
 		}
+		pt_unit(task_submit_0_budget)
+		{
+			while(process_tasks_0() > 0)
+				;
+			size_t count = 0;
+			for(size_t i = 0; i != 8; ++i)
+			{
+				submit_task_0([&count, i]()
+											{
+												pt_check(count == i);	 // NOTE: Single producer, runs in order
+												++count;
+												const high_resolution_point_t e = high_resolution_clock_t::now() + milliseconds_t(2);
+												while(high_resolution_clock_t::now() < e)
+													;
+											});
+			}
+			pt_check(process_tasks_0_for(nanoseconds_t(0)) == 8);
+			pt_check(count == 0);
+			const uint32_t l = process_tasks_0_for(milliseconds_t(3));
+			pt_check(count >= 1 && count < 8);
+			pt_check(l == 8 - count);
+			pt_check(process_tasks_0_until(high_resolution_clock_t::now() + hours_t(1)) == 0);
+			pt_check(count == 8);
+		}
+		pt_unit(future_task_cancel)
+		{
+			// Cancelled before it starts -> Dropped
+			cancel_source c;
+			c.cancel();
+			pf_alignas(CCY_ALIGN) atomic<bool> ran = false;
+			auto f = submit_future_task(c.token(), [&ran]()
+																	{ ran.store(true, atomic_order::relaxed); return 1; });
+			f.wait();
+			pt_check(f.is_cancelled());
+			pt_check(!ran.load(atomic_order::relaxed));
+			try
+			{
+				(void)f.value();
+				pt_check(false);
+			} catch(const dbg_exception &__e)
+			{
+				pt_check(__e.category() == dbg_category_generic());
+			}
+
+			// Running -> Polls its token
+			cancel_source d;
+			auto g = submit_future_task(d.token(), [t = d.token()]()
+																	{ while(!t.is_cancelled()) this_thread::yield(); });
+			d.cancel();
+			g.wait();
+			pt_check(g.is_finished());
+
+			// Never cancelled -> Runs
+			cancel_source e;
+			auto h = submit_future_task(e.token(), [](size_t __i)
+																	{ return __i; },
+																	10);
+			pt_check(h.value() == 10);
+			pt_check(!h.is_cancelled());
+		}
+
+		pt_unit(future_task_then)
+		{
+			auto f = submit_future_task([]()
+																	{ return 20; })
+								.then([](int32_t __v)
+											{ return __v + 1; })
+								.then([](int32_t __v)
+											{ return __v * 2; });
+			pt_check(f.value() == 42);
+
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> count = 0;
+			auto v																			 = submit_future_task([c = &count]()
+																								{ c->fetch_add(1, atomic_order::relaxed); })
+								.then([c = &count]()
+											{ return c->fetch_add(1, atomic_order::relaxed); });
+			pt_check(v.value() == 1);
+
+			auto e = submit_future_task_0([]() -> int32_t
+																		{ pf_throw(dbg_category_generic(), dbg_code::runtime_error, dbg_flags::none, "Main thread failure!"); })
+								.then([](int32_t __v)
+											{ return __v + 1; });
+			bool thrown = false;
+			try
+			{
+				ignore = e.value();	 // NOTE: The exception reaches the continuation, never an uninitialised value
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+		}
+		pt_unit(future_when_all)
+		{
+			auto a = submit_future_task([]()
+																	{ return 20; });
+			auto b = submit_future_task_0([]()
+																		{ return 22; });
+			task_pool_t p;
+			auto c = p.submit_future_task([]() {});
+			auto w = when_all(a, b, c).then([&a, &b]()
+																			{ return a.value() + b.value(); });
+			pt_check(w.value() == 42);
+
+			future<size_t> r[] = { submit_future_task([](size_t __i)
+																								{ return __i; },
+																								size_t(1)),
+														 submit_future_task([](size_t __i)
+																								{ return __i; },
+																								size_t(2)) };
+			auto all = when_all(begin(r), end(r));
+			all.wait();
+			pt_check(r[0].is_finished() && r[1].is_finished());
+			pt_check(when_all(begin(r), begin(r)).is_finished());
+		}
+		pt_unit(future_when_any)
+		{
+			pf_alignas(CCY_ALIGN) atomic<bool> gate = false;
+			auto a																	= submit_future_task([&gate]()
+																	{ while(!gate.load(atomic_order::acquire)) this_thread::yield(); });
+			auto b																	= submit_future_task_0([]()
+																		{ return 1; });	// NOTE: Run by this thread while it waits, even with a single worker
+			auto w																	= when_any(a, b);
+			pt_check(w.value() == 1);
+			gate.store(true, atomic_order::release);
+			a.wait();
+
+			future<size_t> r[] = { submit_future_task([]()
+																								{ return size_t(1); }) };
+			bool thrown = false;
+			try
+			{
+				ignore = when_any(begin(r), begin(r));
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+		}
+		pt_unit(coroutine_await_future)
+		{
+			auto f = __co_add(20, 22);
+			pt_check(f.value() == 42);
+
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> count = 0;
+			__co_count(&count).wait();
+			pt_check(count.load(atomic_order::relaxed) == 16);
+		}
+		pt_unit(coroutine_resume_0)
+		{
+			auto f = __co_main();
+			pt_check(f.value() == this_thread::get_idx());
+		}
+		pt_unit(task_graph_diamond)
+		{
+			// a -> (b, c) -> d
+			pf_alignas(CCY_ALIGN) atomic<uint32_t> step = 0;
+			uint32_t order[4]														= { 0 };
+			task_graph_t g;
+			const uint32_t a = g.add([&]()
+															 { order[0] = step.fetch_add(1, atomic_order::relaxed); });
+			const uint32_t b = g.add([&]()
+															 { order[1] = step.fetch_add(1, atomic_order::relaxed); });
+			const uint32_t c = g.add([&]()
+															 { order[2] = step.fetch_add(1, atomic_order::relaxed); });
+			const uint32_t d = g.add([&]()
+															 { order[3] = step.fetch_add(1, atomic_order::relaxed); });
+			g.precede(a, b);
+			g.precede(a, c);
+			g.precede(b, d);
+			g.precede(c, d);
+			for(uint32_t f = 0; f != 64; ++f)	 // NOTE: Built once, run every frame
+			{
+				step.store(0, atomic_order::relaxed);
+				g.run();
+				g.wait();
+				pt_check(order[0] == 0);
+				pt_check(order[1] < 3 && order[2] < 3);
+				pt_check(order[3] == 3);
+			}
+		}
+		pt_unit(task_graph_exception)
+		{
+			task_graph_t g;
+			pf_alignas(CCY_ALIGN) atomic<bool> after = false;
+			const uint32_t a													 = g.add([]()
+															 { pf_throw(dbg_category_generic(), dbg_code::runtime_error, dbg_flags::none, "Graph node failure!"); });
+			const uint32_t b = g.add([&]()
+															 { after.store(true, atomic_order::relaxed); });
+			g.precede(a, b);
+			g.run();
+			try
+			{
+				g.wait();
+				pt_check(false);
+			} catch(const dbg_exception &__e)
+			{
+				pt_check(__e.category() == dbg_category_generic());
+			} catch(std::exception const &__e)
+			{
+				pt_check(false);
+			}
+			pt_check(after.load(atomic_order::relaxed));
+		}
+		pt_unit(task_graph_cycle)
+		{
+			task_graph_t g;
+			const uint32_t a = g.add([]() {});
+			const uint32_t b = g.add([]() {});
+			const uint32_t c = g.add([]() {});
+			g.precede(a, b);
+			g.precede(b, c);
+			g.precede(c, a);
+			bool thrown = false;
+			try
+			{
+				g.run();
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+			pt_check(g.is_finished());	// NOTE: Nothing was released
+		}
 
 		pt_unit(task_pool)
 		{
@@ -113,6 +1104,38 @@ namespace pul
 			auto f2 = pool.submit_future_task_0([]()
 																					{ return this_thread::get_idx(); });
 		}
+		pt_unit(task_strand)
+		{
+			strand_t s;
+			size_t order[1'024];
+			size_t n = 0;	 // NOTE: Only touched by the strand, no synchronization
+			for(size_t i = 0; i != countof(order); ++i)
+			{
+				s.submit_task([&order, &n](size_t __i)
+											{ order[n++] = __i; },
+											i);
+			}
+			s.wait();
+			pt_check(n == countof(order));
+			bool fifo = true;
+			for(size_t i = 0; i != countof(order); ++i) fifo &= order[i] == i;
+			pt_check(fifo);
+
+			auto f1 = s.submit_future_task(
+			 []()
+			 { pf_throw(dbg_category_generic(), dbg_code::invalid_argument, dbg_flags::none, "A C++ exception from thread={}!", this_thread::get_id()); });
+			auto f2 = s.submit_future_task([&n]()
+																		 { return ++n; });
+			try
+			{
+				f1.check_exception();
+				pt_check(false);
+			} catch(const dbg_exception &__e)
+			{
+				pt_check(__e.category() == dbg_category_generic());
+			}
+			pt_check(f2.value() == countof(order) + 1);	 // NOTE: The chain goes on after a throw
+		}
 
 		pt_unit(task_throw)
 		{
@@ -146,5 +1169,28 @@ namespace pul
 				pt_check(false);
 			}
 		}
+		pt_unit(task_help_throw_0)
+		{
+			submit_task_0(
+			 []()
+			 { pf_throw(dbg_category_generic(), dbg_code::invalid_argument, dbg_flags::none, "A C++ exception from thread={}!", this_thread::get_id()); });
+			auto f = submit_future_task(
+			 []()
+			 {
+				 this_thread::sleep_for(nanoseconds_t(10'000'000));
+				 return 1;
+			 });
+			pt_check(f.value() == 1);	 // NOTE: The main thread helps with queue0 while waiting, the throw is kept
+			bool thrown = false;
+			try
+			{
+				while(process_tasks_0() != 0)
+					;
+			} catch(const dbg_exception &__e)
+			{
+				thrown = __e.category() == dbg_category_generic();
+			}
+			pt_check(thrown);
+		}
 	}
 }	 // namespace pul